@@ -1,10 +1,14 @@
 
+#include <algorithm>
+#include <cmath>
+
 #include <SDL.h>
 #include <SDL_ttf.h>
 
 #include <spdlog/spdlog.h>
 
 #include "app.h"
+#include "core/profiler.h"
 #include "core/renderer.h"
 
 // -----------------------------------------------------------------------------
@@ -14,7 +18,15 @@
 /** Enforce single-object rule without global singleton. */
 static bool isAppConstructed{false};
 
-App::App(const Config& config) {
+App::App(const Config& config)
+    : isRunning{false}, isHeadless{config.headless},
+      tickSeconds{1.0 / std::max(config.tickRate, 1u)},
+      maxTicksPerFrame{std::max(config.maxTicksPerFrame, 1u)},
+      inputQueue{config.queueInput && !config.headless
+                     ? std::make_unique<SpscRing<InputEvent, 256>>()
+                     : nullptr},
+      pacer{config.pacer},
+      frameStats{config.stats}, traceFile{config.traceFile} {
     // --- Enforce single-construction.
     // Do not throw exception! No catching around this rule!
     if (isAppConstructed) {
@@ -54,10 +66,19 @@ App::App(const Config& config) {
     }
 
     // --- Initialize Sub-systems
+    // Vsync pacing is delegated to the renderer's present.
+    Renderer::Config rendererConfig{config.renderer};
+    rendererConfig.vsync |= pacer.isVsync();
+
     Display::getMutable().initialize(config.display);
-    Renderer::getMutable().initialize(config.renderer);
+    Renderer::getMutable().initialize(rendererConfig);
 }
 App::~App() {
+    if (isHeadless) {
+        SDL_Quit();
+        return;
+    }
+
     // --- Terminate Sub-systems
     Renderer::getMutable().terminate();
     Display::getMutable().terminate();
@@ -79,68 +100,190 @@ void App::start() {
     // Set running flag.
     isRunning = true;
 
-    /** CPU ticks at the start of the last frame. */
-    uint64_t previousFrameTicks = SDL_GetTicks64();
+#if PONG_PROFILE
+    Profiler::setThreadName("Main");
+#endif
 
-    /** CPU ticks at the start of this frame. */
-    uint64_t currentFrameTicks = 0;
+    if (isHeadless) {
+        runHeadlessLoop();
+    } else {
+        runFrameLoop();
+    }
 
-    /** Time at the beginning of the frame. */
-    uint64_t frameStartTime = 0;
+#if PONG_PROFILE
+    if (!traceFile.empty()) {
+        Profiler::exportChromeTrace(traceFile);
+    }
+#endif
 
-    /** Time at the end of the frame. */
-    uint64_t frameEndTime = 0;
+    spdlog::info("Application stopped");
+}
 
-    /** Milliseconds this frame has taken. */
-    float elapsedFrameMs = 0;
+void App::stop() {
+    spdlog::info("Stopping application...");
+    isRunning = false;
+}
+
+const FrameStats& App::getFrameStats() const { return frameStats; }
+
+// -----------------------------------------------------------------------------
+// Loops
+// -----------------------------------------------------------------------------
+
+void App::runFrameLoop() {
+    /** Performance counter ticks per second. */
+    const double counterFrequency = SDL_GetPerformanceFrequency();
+
+    /** Performance counter at the start of the last frame. */
+    uint64_t previousFrameCounter = SDL_GetPerformanceCounter();
+
+    /** Performance counter at the start of this frame. */
+    uint64_t currentFrameCounter = 0;
 
     /** Time between frames. Measured in seconds. */
-    float delta = 0;
+    double frameSeconds = 0;
+
+    /** Time not yet consumed by the simulation. Measured in seconds. */
+    double accumulator = 0;
+
+    /** Has a whole frame run yet? The first has no predecessor to time. */
+    bool isFrameTimed = false;
+
+    /** Longest stretch of time a single frame may feed the simulation. */
+    const double maxFrameSeconds = tickSeconds * maxTicksPerFrame;
 
     // --- Application Loop
     while (isRunning) {
 
         // --- Start Frame Timing
 
-        frameStartTime    = SDL_GetPerformanceCounter();
-        currentFrameTicks = SDL_GetTicks64();
-        delta             = (currentFrameTicks - previousFrameTicks) / 1000.0f;
+        currentFrameCounter  = SDL_GetPerformanceCounter();
+        frameSeconds         = (currentFrameCounter - previousFrameCounter) /
+                       counterFrequency;
+        previousFrameCounter = currentFrameCounter;
+
+        // The time since the last frame started is how long it took.
+        if (isFrameTimed) {
+            frameStats.addFrame(frameSeconds, Renderer::get().getCounters());
+        }
+        isFrameTimed = true;
+
+        // Drop time we could never catch up on (debugger breaks, window
+        // drags, etc.) instead of spiralling into ever-longer frames.
+        accumulator += std::min(frameSeconds, maxFrameSeconds);
 
         // --- Poll input events
         /** Input Event Processing */
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            this->dispatchEvent(event);
+        {
+            PROFILE_ZONE("App::pollEvents");
+            pumpEvents();
         }
 
-        // --- Process Frame
-        this->processFrame(delta);
+        // --- Simulate in fixed-size ticks
+        unsigned int ticks = 0;
+        {
+            PROFILE_ZONE("App::simulate");
+            while (accumulator >= tickSeconds && ticks < maxTicksPerFrame &&
+                   isRunning) {
+                // This tick ends `accumulator - tickSeconds` before now;
+                // input from before then happened during it.
+                if (inputQueue) {
+                    dispatchInputUntil(
+                        currentFrameCounter -
+                        static_cast<uint64_t>((accumulator - tickSeconds) *
+                                              counterFrequency));
+                }
+                this->simulate(static_cast<float>(tickSeconds));
+                accumulator -= tickSeconds;
+                ++ticks;
+            }
+        }
+
+        // Any whole ticks still owed past the budget are forfeited.
+        if (accumulator >= tickSeconds) {
+            accumulator = std::fmod(accumulator, tickSeconds);
+        }
 
-        // --- End Frame Timing
-        //
-        previousFrameTicks = currentFrameTicks;
-        frameEndTime       = SDL_GetPerformanceCounter();
-        elapsedFrameMs     = (frameEndTime - frameStartTime) /
-                         (float)SDL_GetPerformanceFrequency() * 1000.0f;
+        // --- Render, interpolating between the last two simulation states
+        {
+            PROFILE_ZONE("App::render");
+            this->render(static_cast<float>(accumulator / tickSeconds));
+        }
 
-        // 60 FPS in Milliseconds
-        // == 1 (frame) / 60 (seconds) * 1000 (convert to ms)
-        static float const FPS60 = 16.666f;
+        // --- End Frame (hold to target rate)
+        PROFILE_ZONE("App::wait");
+        // An unchanged frame isn't presented, so vsync can't hold it back;
+        // sleep for a tick instead of spinning.
+        if (pacer.isVsync() && !Renderer::get().didPresent()) {
+            SDL_Delay(static_cast<uint32_t>(tickSeconds * 1000));
+        }
+        if (inputQueue) {
+            pacer.wait([this]() { pumpEvents(); });
+        } else {
+            pacer.wait();
+        }
+    }
+}
 
-        long frameDelayMs = floor(FPS60 - elapsedFrameMs);
+void App::pumpEvents() {
+    SDL_Event event;
+    if (!inputQueue) {
+        while (SDL_PollEvent(&event)) {
+            this->dispatchEvent(event);
+        }
+        return;
+    }
 
-        // Delay each frame to get as close to 60FPS as possible.
-        if (frameDelayMs < 0)
-            frameDelayMs = 0;
-        SDL_Delay(frameDelayMs);
+    // Whatever this pump finds arrived since the last one. Stamping it with
+    // the earliest time it could have means the frame-start pump's input
+    // still lands in that frame's ticks.
+    const uint64_t counter{lastPumpCounter};
+    lastPumpCounter = SDL_GetPerformanceCounter();
+    while (SDL_PollEvent(&event)) {
+        // Keyboard through gestures: everything a player does.
+        const bool isInput{event.type >= SDL_KEYDOWN &&
+                           event.type < SDL_CLIPBOARDUPDATE};
+        if (!isInput) {
+            this->dispatchEvent(event);
+            continue;
+        }
+        // Full (hundreds of events in one frame): late beats lost.
+        if (!inputQueue->push({counter, event})) {
+            dispatchInputUntil(UINT64_MAX);
+            inputQueue->push({counter, event});
+        }
     }
+}
 
-    spdlog::info("Application stopped");
+void App::dispatchInputUntil(uint64_t counter) {
+    while (const InputEvent* input{inputQueue->peek()}) {
+        if (input->counter > counter) {
+            break;
+        }
+        const SDL_Event event{input->event};
+        inputQueue->pop();
+        this->dispatchEvent(event);
+    }
 }
 
-void App::stop() {
-    spdlog::info("Stopping application...");
-    isRunning = false;
+void App::runHeadlessLoop() {
+    // Polling is far more expensive than a simulation tick, so events are
+    // only drained between batches. They still need draining at all for
+    // SDL_QUIT (e.g. SIGINT) to reach us.
+    static const unsigned int ticksPerPoll{1024};
+
+    const float delta{static_cast<float>(tickSeconds)};
+
+    while (isRunning) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            this->dispatchEvent(event);
+        }
+
+        for (unsigned int tick = 0; tick < ticksPerPoll && isRunning; ++tick) {
+            this->simulate(delta);
+        }
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -150,9 +293,26 @@ void App::stop() {
 void App::dispatchEvent(const SDL_Event& event) {
     switch (event.type) {
     case SDL_DISPLAYEVENT:
+        Display::getMutable().processEvent(event);
+        break;
     case SDL_WINDOWEVENT:
+        // The window's contents may be gone; a partial redraw isn't enough.
+        switch (event.window.event) {
+        case SDL_WINDOWEVENT_SHOWN:
+        case SDL_WINDOWEVENT_EXPOSED:
+        case SDL_WINDOWEVENT_SIZE_CHANGED:
+        case SDL_WINDOWEVENT_RESTORED:
+            Renderer::get().invalidate();
+            break;
+        default:
+            break;
+        }
         Display::getMutable().processEvent(event);
         break;
+    case SDL_RENDER_TARGETS_RESET:
+    case SDL_RENDER_DEVICE_RESET:
+        Renderer::get().invalidate();
+        break;
     case SDL_QUIT:
         stop();
         break;
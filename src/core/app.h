@@ -2,17 +2,27 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 
 #include <SDL_events.h>
 
 #include "display.h"
+#include "frame_pacer.h"
+#include "frame_stats.h"
 #include "renderer.h"
+#include "spsc_ring.h"
 
 /**
  * Core Application class. Subclass to utilize engine functionality.
  *
  * Must implement custom destructor (even if no-op),
- * processEvent, and processFrame.
+ * processEvent, simulate, and render.
+ *
+ * The frame loop runs the simulation at a fixed rate (`Config::tickRate`),
+ * decoupled from the rate at which frames are rendered. Time between frames
+ * is accumulated and consumed in fixed-size ticks; whatever is left over is
+ * handed to `render` as an interpolation factor between the previous and the
+ * current simulation state.
  *
  * This class may not exist as a singleton for design reasons. Instead,
  * it has what is called the "Single Object Rule". Attempts to create
@@ -41,9 +51,37 @@ class App {
      * Sub-system configuration aggregate.
      */
     struct Config {
+        /**
+         * Run without video or fonts. The loop then only simulates: no
+         * rendering, no pacing, as many ticks per second as the CPU allows.
+         */
         bool headless;
-        Display::Config display;
-        Renderer::Config renderer;
+        /** Fixed simulation rate, in ticks per second. */
+        unsigned int tickRate{60};
+        /**
+         * Upper bound on simulation ticks run for a single rendered frame.
+         * Protects against the "spiral of death" after a long stall: time
+         * beyond this budget is dropped rather than caught up on.
+         */
+        unsigned int maxTicksPerFrame{5};
+        /**
+         * Timestamped input. Input events (keyboard, mouse, controllers,
+         * touch) are stamped with the performance counter as they are
+         * pumped, queued, and dispatched just before the first simulation
+         * tick that ends after them, instead of all before the first tick of
+         * the next frame. Events are also pumped while the pacer waits (see
+         * `FramePacer::Config::idleSliceMs`), not only once per frame.
+         */
+        bool queueInput{false};
+        Display::Config display{};
+        Renderer::Config renderer{};
+        FramePacer::Config pacer{};
+        FrameStats::Config stats{};
+        /**
+         * Write a Chrome trace of the profiled zones (see `Profiler`) here
+         * once stopped. Empty, or a build without profiling, writes none.
+         */
+        std::string traceFile{};
     };
 
     virtual ~App();
@@ -63,11 +101,21 @@ class App {
     void stop();
 
     /**
-     * Virtual frame processor.
+     * Virtual simulation step.
+     *
+     * Override to describe how to advance the simulation by a single tick.
+     * Always called with the same `delta` (one over `Config::tickRate`).
+     */
+    virtual void simulate(const float delta) = 0;
+
+    /**
+     * Virtual frame renderer.
      *
-     * Override to describe how to process a single frame.
+     * Override to describe how to draw a single frame. `alpha` in [0, 1)
+     * is how far the frame lies between the previous simulation tick and
+     * the current one, and should be used to interpolate moving geometry.
      */
-    virtual void processFrame(const float delta) = 0;
+    virtual void render(const float alpha) = 0;
 
     /**
      * Virtual event processor.
@@ -81,12 +129,73 @@ class App {
 
     App(const Config& config);
 
+    /**
+     * Frame timing and renderer counters, fed by the frame loop.
+     */
+    const FrameStats& getFrameStats() const;
+
   private:
     /**
      * Dispatch events by type to interested sub-systems.
      */
     void dispatchEvent(const SDL_Event& event);
 
+    /**
+     * Real-time loop: fixed-step simulation, interpolated rendering, paced.
+     */
+    void runFrameLoop();
+
+    /**
+     * Pump SDL, dispatching non-input events and queueing input events.
+     * \sa Config::queueInput
+     */
+    void pumpEvents();
+
+    /**
+     * Dispatch queued input events stamped at or before `counter`.
+     */
+    void dispatchInputUntil(uint64_t counter);
+
+    /**
+     * Headless loop: back-to-back simulation ticks, nothing else.
+     */
+    void runHeadlessLoop();
+
     /** Internal flag used for control-flow. */
     bool isRunning;
+
+    /** See `Config::headless`. */
+    bool isHeadless;
+
+    /** Duration of a single simulation tick. Measured in seconds. */
+    double tickSeconds;
+
+    /** See `Config::maxTicksPerFrame`. */
+    unsigned int maxTicksPerFrame;
+
+    /** An input event and the performance counter when it was pumped. */
+    struct InputEvent {
+        uint64_t counter;
+        SDL_Event event;
+    };
+
+    /**
+     * Pumped, not yet dispatched input; null unless `Config::queueInput`.
+     * Only the main thread touches it today (SDL must pump events on the
+     * thread that created the window), but it is lock-free so that a
+     * producer thread could feed it.
+     */
+    std::unique_ptr<SpscRing<InputEvent, 256>> inputQueue;
+
+    /** Performance counter at the last `pumpEvents`. */
+    uint64_t lastPumpCounter{0};
+
+    /** Holds the loop to the configured frame rate. */
+    FramePacer pacer;
+
+    /** Fed once per frame by `runFrameLoop`. */
+    FrameStats frameStats;
+
+    /** See `Config::traceFile`. */
+    std::string traceFile;
 };
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal micro-benchmark harness.
+ *
+ * `runBenchmark` calls `body` in doubling batches until one batch takes at
+ * least `minSeconds`, then reports the mean wall time per call of that batch.
+ *
+ * Every result is also kept for `finishBenchmarks`, which writes them as JSON
+ * when the program is run with `--benchmark_out=<path>`. The layout follows
+ * Google Benchmark's, so its `compare.py` (and anything else that reads it)
+ * can diff two runs.
+ */
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t iterations;
+    /** Mean wall time per iteration. */
+    double nanoseconds;
+};
+
+/**
+ * Keep the compiler from discarding `value` (and the work producing it).
+ */
+template <typename T> inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Every result so far, in the order run.
+ */
+inline std::vector<BenchmarkResult>& getBenchmarkResults() {
+    static std::vector<BenchmarkResult> results;
+    return results;
+}
+
+template <typename Body>
+BenchmarkResult runBenchmark(const std::string& name, Body&& body,
+                             double minSeconds = 0.25) {
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t iterations{1};
+    double seconds{0};
+    while (true) {
+        const Clock::time_point start{Clock::now()};
+        for (uint64_t idx = 0; idx < iterations; ++idx) {
+            body();
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= minSeconds) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    const BenchmarkResult result{name, iterations, seconds * 1e9 / iterations};
+    std::printf("%-48s %12llu %16.1f ns\n", result.name.c_str(),
+                static_cast<unsigned long long>(result.iterations),
+                result.nanoseconds);
+    getBenchmarkResults().push_back(result);
+    return result;
+}
+
+/**
+ * Write the results to the file named by `--benchmark_out=<path>`, if given.
+ * Returns the exit status for `main`.
+ */
+inline int finishBenchmarks(int argc, char** argv) {
+    static const char flag[]{"--benchmark_out="};
+    const char* path{nullptr};
+    for (int idx = 1; idx < argc; ++idx) {
+        if (std::strncmp(argv[idx], flag, sizeof(flag) - 1) == 0) {
+            path = argv[idx] + sizeof(flag) - 1;
+        }
+    }
+    if (!path) {
+        return 0;
+    }
+
+    std::FILE* file{std::fopen(path, "w")};
+    if (!file) {
+        std::fprintf(stderr, "Could not open %s for writing\n", path);
+        return 1;
+    }
+    std::fprintf(file, "{\n  \"context\": {\"executable\": \"%s\"},\n", argv[0]);
+    std::fputs("  \"benchmarks\": [", file);
+    const char* separator{""};
+    for (const BenchmarkResult& result : getBenchmarkResults()) {
+        // Wall time only; the harness doesn't measure CPU time separately.
+        std::fprintf(file,
+                     "%s\n    {\"name\": \"%s\", \"run_type\": \"iteration\", "
+                     "\"iterations\": %llu, \"real_time\": %.3f, "
+                     "\"cpu_time\": %.3f, \"time_unit\": \"ns\"}",
+                     separator, result.name.c_str(),
+                     static_cast<unsigned long long>(result.iterations),
+                     result.nanoseconds, result.nanoseconds);
+        separator = ",";
+    }
+    std::fputs("\n  ]\n}\n", file);
+    return std::fclose(file) == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#include <array>
+#include <cstdint>
+
+#include "core/benchmarks/benchmark.h"
+#include "core/rect.h"
+
+/**
+ * `Rect` collision primitives, one call per iteration.
+ *
+ * Calls cycle through a fixed set of rects scattered around (and partly
+ * overlapping) a paddle-sized target, so neither the branch predictor nor
+ * the optimizer sees the same inputs every time.
+ */
+
+static const std::size_t rectCount{1024};
+
+static std::array<Rect, rectCount> makeRects() {
+    // Fixed-seed xorshift, so every run sees the same scatter.
+    uint32_t state{2463534242u};
+    const auto next = [&state](int range) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<int>(state % static_cast<uint32_t>(range));
+    };
+
+    std::array<Rect, rectCount> rects;
+    for (Rect& rect : rects) {
+        rect = Rect{next(64) - 16, next(96) - 16, 4 + next(12), 4 + next(12)};
+    }
+    return rects;
+}
+
+int main(int argc, char** argv) {
+    const Rect target{16, 16, 8, 64};
+    const std::array<Rect, rectCount> rects{makeRects()};
+    std::size_t idx{0};
+    const auto nextRect = [&]() -> const Rect& { return rects[idx++ % rectCount]; };
+
+    runBenchmark("rect/operator-", [&]() { doNotOptimize(target - nextRect()); });
+
+    runBenchmark("rect/minkowskiDifference",
+                 [&]() { doNotOptimize(target.minkowskiDifference(nextRect())); });
+
+    runBenchmark("rect/hasPoint", [&]() {
+        const Rect& rect{nextRect()};
+        doNotOptimize(target.hasPoint(rect.x, rect.y));
+    });
+
+    runBenchmark("rect/getIntersectingEdge",
+                 [&]() { doNotOptimize(target.getIntersectingEdge(nextRect())); });
+
+    runBenchmark("rect/getSweptImpact", [&]() {
+        const Rect& rect{nextRect()};
+        const Vector2 displacement{rect.w * 4 - 32, rect.h * 4 - 32};
+        doNotOptimize(target.getSweptImpact(rect, displacement));
+    });
+
+    return finishBenchmarks(argc, argv);
+}
@@ -24,7 +24,8 @@ void Display::initialize(const Config& config) {
     // TODO: support flags (fullscreen etc.)
     window = SDL_CreateWindow(config.windowTitle.c_str(), config.windowPositionX,
                               config.windowPositionY, config.windowWidth,
-                              config.windowHeight, 0);
+                              config.windowHeight,
+                              config.resizable ? SDL_WINDOW_RESIZABLE : 0u);
     if (!window) {
         spdlog::error("{} Error: Failed to create window!");
     }
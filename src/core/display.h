@@ -18,6 +18,8 @@ class Display {
         unsigned int windowPositionY;
         unsigned int windowWidth;
         unsigned int windowHeight;
+        /** Let the user resize (and maximize) the window. */
+        bool resizable{false};
     };
 
     ~Display();
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+
+/**
+ * Signed 16.16 fixed-point number.
+ *
+ * Used for simulation state (positions, velocities) so that sub-pixel
+ * motion accumulates exactly, and so that the same inputs give bit-for-bit
+ * the same results on every machine and at every frame rate. Whole pixels
+ * range over +/- 32767.
+ *
+ * Conversions to `int` round to the nearest whole number (halves up).
+ */
+struct Fixed {
+    using Raw = int32_t;
+
+    static constexpr int fractionBits{16};
+    static constexpr Raw one{Raw{1} << fractionBits};
+
+    Raw raw{0};
+
+    // --- Conversion
+
+    static constexpr Fixed fromRaw(Raw raw) { return Fixed{raw}; }
+    static constexpr Fixed fromInt(int value) { return Fixed{value * one}; }
+    static constexpr Fixed fromFloat(float value) {
+        const float scaled{value * one};
+        return Fixed{static_cast<Raw>(scaled < 0 ? scaled - 0.5f : scaled + 0.5f)};
+    }
+
+    constexpr int toInt() const { return (raw + one / 2) >> fractionBits; }
+    constexpr float toFloat() const { return static_cast<float>(raw) / one; }
+
+    // --- Arithmetic
+
+    constexpr Fixed operator+(Fixed rhs) const { return Fixed{raw + rhs.raw}; }
+    constexpr Fixed operator-(Fixed rhs) const { return Fixed{raw - rhs.raw}; }
+    constexpr Fixed operator-() const { return Fixed{-raw}; }
+
+    constexpr Fixed operator*(Fixed rhs) const {
+        return Fixed{static_cast<Raw>((int64_t{raw} * rhs.raw) >> fractionBits)};
+    }
+
+    constexpr Fixed operator/(Fixed rhs) const {
+        return Fixed{static_cast<Raw>((int64_t{raw} << fractionBits) / rhs.raw)};
+    }
+
+    constexpr Fixed& operator+=(Fixed rhs) { return *this = *this + rhs; }
+    constexpr Fixed& operator-=(Fixed rhs) { return *this = *this - rhs; }
+
+    constexpr auto operator<=>(const Fixed&) const = default;
+};
@@ -3,7 +3,7 @@
 #include "font.h"
 
 Font::Font(const std::string path, const int size)
-    : data{TTF_OpenFont(path.c_str(), size)} {
+    : data{TTF_OpenFont(path.c_str(), size)}, path{path}, points{size} {
     if (!data) {
         spdlog::error("Cannot create Font object: {}", TTF_GetError());
         abort();
@@ -11,7 +11,7 @@ Font::Font(const std::string path, const int size)
 }
 Font::~Font() { TTF_CloseFont(data); }
 
-Font::Font(Font&& other) {
+Font::Font(Font&& other) : path{std::move(other.path)}, points{other.points} {
     data       = other.data;
     other.data = nullptr;
 }
@@ -21,8 +21,12 @@ Font& Font::operator=(Font&& rhs) {
         TTF_CloseFont(data);
     }
     data     = rhs.data;
+    path     = std::move(rhs.path);
+    points   = rhs.points;
     rhs.data = nullptr;
     return *this;
 }
 
 TTF_Font* Font::get() const { return data; }
+const std::string& Font::getPath() const { return path; }
+int Font::getPoints() const { return points; }
@@ -15,8 +15,15 @@ class Font {
 
     TTF_Font* get() const;
 
+    /** File the font was opened from. */
+    const std::string& getPath() const;
+    /** Point size the font was opened at. */
+    int getPoints() const;
+
   private:
     TTF_Font* data;
+    std::string path;
+    int points;
     Font(const Font& other);
     Font& operator=(const Font& rhs);
 };
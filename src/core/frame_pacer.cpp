@@ -0,0 +1,61 @@
+#include <algorithm>
+
+#include <SDL_timer.h>
+
+#include "frame_pacer.h"
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+
+FramePacer::FramePacer(const Config& config)
+    : mode{config.mode}, counterFrequency{SDL_GetPerformanceFrequency()},
+      periodTicks{counterFrequency / std::max(config.targetRate, 1u)},
+      spinTicks{static_cast<uint64_t>(counterFrequency * config.spinMs / 1000.0f)},
+      idleSliceMs{std::max(config.idleSliceMs, 1u)} {}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+bool FramePacer::isVsync() const { return mode == Mode::vsync; }
+
+void FramePacer::wait(const IdleCallback& idle) {
+    if (mode != Mode::capped) {
+        return;
+    }
+
+    uint64_t now{SDL_GetPerformanceCounter()};
+
+    // First frame, or fell more than a whole frame behind: resynchronize
+    // instead of rushing through a burst of frames to catch up.
+    if (deadline == 0 || now > deadline + periodTicks) {
+        deadline = now + periodTicks;
+        return;
+    }
+
+    // --- Coarse sleep, stopping short of the deadline by the spin window.
+    // With idle work, sleep in slices and do it in between.
+    while (deadline > now + spinTicks) {
+        const uint64_t sleepTicks{deadline - now - spinTicks};
+        uint32_t sleepMs{static_cast<uint32_t>(sleepTicks * 1000 / counterFrequency)};
+        if (idle) {
+            idle();
+            sleepMs = std::min(sleepMs, idleSliceMs);
+        }
+        if (sleepMs == 0) {
+            break;
+        }
+        SDL_Delay(sleepMs);
+        if (!idle) {
+            break;
+        }
+        now = SDL_GetPerformanceCounter();
+    }
+
+    // --- Fine spin for the remainder.
+    while (SDL_GetPerformanceCounter() < deadline) {
+    }
+
+    deadline += periodTicks;
+}
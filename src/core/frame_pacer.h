@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+/**
+ * Frame pacing sub-system. Holds the application loop to a target frame rate.
+ *
+ * `SDL_Delay` alone routinely oversleeps by a millisecond or two, so the pacer
+ * sleeps coarsely until shortly before the frame deadline, then spins on the
+ * performance counter for the remainder.
+ *
+ * Deadlines advance by exactly one frame period each frame (rather than being
+ * measured from whenever the frame happened to end), so rounding error does
+ * not accumulate into drift.
+ *
+ * TODO: Tests
+ */
+class FramePacer {
+  public:
+    /**
+     * Pacing strategy.
+     */
+    enum class Mode {
+        /** Sleep/spin to `Config::targetRate`. */
+        capped,
+        /** Never wait; run frames back-to-back. */
+        uncapped,
+        /** Let the renderer block on the display's refresh (present vsync). */
+        vsync,
+    };
+
+    struct Config {
+        Mode mode{Mode::capped};
+        /** Frames per second, used by `Mode::capped` only. */
+        unsigned int targetRate{60};
+        /**
+         * Length of the busy-wait at the end of each frame, in milliseconds.
+         * Should cover the scheduler's worst-case oversleep.
+         */
+        float spinMs{2.0f};
+        /**
+         * Longest single sleep, in milliseconds, when `wait` is given an idle
+         * callback: the callback runs between sleeps at about this interval.
+         */
+        unsigned int idleSliceMs{1};
+    };
+
+    /** Work to do while waiting, e.g. pumping input. Must be quick. */
+    using IdleCallback = std::function<void()>;
+
+    FramePacer(const Config& config);
+
+    /**
+     * Is the renderer expected to pace frames (present with vsync)?
+     */
+    bool isVsync() const;
+
+    /**
+     * Block until the current frame's deadline, then schedule the next one.
+     * Does nothing unless in `Mode::capped`. If given, `idle` is called
+     * every `Config::idleSliceMs` while sleeping (not while spinning).
+     */
+    void wait(const IdleCallback& idle = {});
+
+  private:
+    Mode mode;
+
+    /** Performance counter ticks per second. */
+    uint64_t counterFrequency;
+
+    /** Frame period, in performance counter ticks. */
+    uint64_t periodTicks;
+
+    /** Busy-wait length, in performance counter ticks. */
+    uint64_t spinTicks;
+
+    /** See `Config::idleSliceMs`. */
+    uint32_t idleSliceMs;
+
+    /** Performance counter value the current frame must end at. */
+    uint64_t deadline{0};
+};
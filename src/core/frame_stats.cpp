@@ -0,0 +1,96 @@
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "frame_stats.h"
+
+static const std::string TAG{"Frame Stats"};
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+
+FrameStats::FrameStats(const Config& config)
+    : frameMs(std::max<std::size_t>(config.window, 1)),
+      summarySeconds{config.summarySeconds}, logSeconds{config.logSeconds} {}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+void FrameStats::addFrame(double seconds, const Renderer::Counters& totals) {
+    // --- Slide the window
+    const double ms{seconds * 1000};
+    double& slot{frameMs[frames % frameMs.size()]};
+    if (frames >= frameMs.size()) {
+        --buckets[getBucket(slot)];
+    }
+    slot = ms;
+    ++buckets[getBucket(ms)];
+    ++frames;
+
+    // --- Summarize / log now and then
+    ++framesSinceSummary;
+    secondsSinceSummary += seconds;
+    secondsSinceLog += seconds;
+    if (secondsSinceSummary < summarySeconds) {
+        return;
+    }
+    summarize(totals);
+
+    if (logSeconds > 0 && secondsSinceLog >= logSeconds) {
+        secondsSinceLog = 0;
+        spdlog::info("{}: fps={:.1f} p50_ms={:.1f} p95_ms={:.1f} p99_ms={:.1f} "
+                     "max_ms={:.2f} draw_calls={:.1f} texture_binds={:.1f} "
+                     "texture_uploads={:.2f}",
+                     TAG, summary.fps, summary.p50, summary.p95, summary.p99,
+                     summary.max, summary.drawCalls, summary.textureBinds,
+                     summary.textureUploads);
+    }
+}
+
+const FrameStats::Summary& FrameStats::getSummary() const { return summary; }
+
+uint64_t FrameStats::getFrameCount() const { return frames; }
+
+// -----------------------------------------------------------------------------
+// Private Methods
+// -----------------------------------------------------------------------------
+
+std::size_t FrameStats::getBucket(double ms) {
+    return std::min(static_cast<std::size_t>(ms / bucketMs), bucketCount - 1);
+}
+
+double FrameStats::getPercentile(double fraction) const {
+    const uint64_t samples{std::min<uint64_t>(frames, frameMs.size())};
+    const uint64_t rank{static_cast<uint64_t>(fraction * (samples - 1)) + 1};
+    uint64_t seen{0};
+    for (std::size_t bucket = 0; bucket < bucketCount - 1; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            // Upper edge: never flatter than the truth.
+            return (bucket + 1) * bucketMs;
+        }
+    }
+    return summary.max;
+}
+
+void FrameStats::summarize(const Renderer::Counters& totals) {
+    const uint64_t samples{std::min<uint64_t>(frames, frameMs.size())};
+    summary.max = *std::max_element(frameMs.begin(), frameMs.begin() + samples);
+    summary.p50 = getPercentile(0.50);
+    summary.p95 = getPercentile(0.95);
+    summary.p99 = getPercentile(0.99);
+    summary.fps = framesSinceSummary / secondsSinceSummary;
+
+    const double frameCount{static_cast<double>(framesSinceSummary)};
+    summary.drawCalls = (totals.drawCalls - totalsAtSummary.drawCalls) / frameCount;
+    summary.textureBinds =
+        (totals.textureBinds - totalsAtSummary.textureBinds) / frameCount;
+    summary.textureUploads =
+        (totals.textureUploads - totalsAtSummary.textureUploads) / frameCount;
+
+    totalsAtSummary     = totals;
+    framesSinceSummary  = 0;
+    secondsSinceSummary = 0;
+}
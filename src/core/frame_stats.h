@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "renderer.h"
+
+/**
+ * Frame timing and renderer counters, for the on-screen overlay and for
+ * the logs.
+ *
+ * Frame times go into a histogram over a rolling window of recent frames
+ * (0.1 ms buckets up to 100 ms, anything longer in an overflow bucket), so
+ * percentiles cost a walk over the buckets rather than a sort. Renderer
+ * counters are averaged per frame between summaries.
+ *
+ * The summary is refreshed a few times a second, and written to the log
+ * every `Config::logSeconds`, as `key=value` pairs for easy scraping.
+ *
+ * TODO: Tests
+ */
+class FrameStats {
+  public:
+    struct Config {
+        /** Frames in the rolling window. */
+        std::size_t window{600};
+        /** Seconds between summaries. */
+        float summarySeconds{0.5f};
+        /** Seconds between log lines. Zero means never. */
+        float logSeconds{10};
+    };
+
+    struct Summary {
+        double fps{0};
+        /** Frame time percentiles over the window, in milliseconds. */
+        double p50{0};
+        double p95{0};
+        double p99{0};
+        double max{0};
+        /** Per-frame means since the last summary. */
+        double drawCalls{0};
+        double textureBinds{0};
+        double textureUploads{0};
+    };
+
+    FrameStats(const Config& config);
+
+    /**
+     * Add a frame that took `seconds`. `totals` are the renderer's counters
+     * as of the end of it.
+     */
+    void addFrame(double seconds, const Renderer::Counters& totals);
+
+    const Summary& getSummary() const;
+
+    /** Frames added so far. */
+    uint64_t getFrameCount() const;
+
+  private:
+    static constexpr double bucketMs{0.1};
+    static constexpr std::size_t bucketCount{1001};
+
+    // --- Rolling Window
+    std::vector<double> frameMs;
+    std::array<uint32_t, bucketCount> buckets{};
+    uint64_t frames{0};
+
+    // --- Since Last Summary / Log Line
+    float summarySeconds;
+    float logSeconds;
+    double secondsSinceSummary{0};
+    double secondsSinceLog{0};
+    uint64_t framesSinceSummary{0};
+    Renderer::Counters totalsAtSummary{};
+
+    Summary summary;
+
+    static std::size_t getBucket(double ms);
+    double getPercentile(double fraction) const;
+    void summarize(const Renderer::Counters& totals);
+};
@@ -0,0 +1,22 @@
+#include "glyph_atlas.h"
+
+GlyphAtlas::GlyphAtlas(Texture&& texture, const GlyphContainerType& glyphs,
+                       int lineHeight)
+    : texture{std::move(texture)}, glyphs{glyphs}, lineHeight{lineHeight} {}
+
+const GlyphAtlas::Glyph* GlyphAtlas::getGlyph(char character) const {
+    if (character < first || character > last) {
+        return nullptr;
+    }
+    return &glyphs[character - first];
+}
+
+Vector2 GlyphAtlas::measure(const std::string& text) const {
+    int width{0};
+    for (char character : text) {
+        if (const Glyph* glyph{getGlyph(character)}) {
+            width += glyph->advance;
+        }
+    }
+    return Vector2{width, lineHeight};
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "SDL_rect.h"
+
+#include "texture.h"
+#include "vector2.h"
+
+/**
+ * A font's printable ASCII glyphs, rasterized once into a single texture.
+ *
+ * Text is drawn from the atlas as one batch of textured quads (see
+ * `Renderer::drawText`), so changing text (scores, timers, ...) costs no
+ * rasterization, no texture uploads, and a single texture bind per string.
+ * Glyphs are white; text is tinted per draw through vertex colors.
+ *
+ * Build one per `Font` with `Renderer::loadGlyphAtlas`.
+ *
+ * TODO: Tests
+ */
+struct GlyphAtlas {
+    /** First and last characters in the atlas (printable ASCII). */
+    static constexpr char first{' '};
+    static constexpr char last{'~'};
+    static constexpr std::size_t count{last - first + 1};
+
+    struct Glyph {
+        /** Where the glyph's cell is in the atlas texture. */
+        SDL_Rect source;
+        /** How far to move the pen after drawing this glyph. */
+        int advance;
+    };
+
+    using GlyphContainerType = std::array<Glyph, count>;
+
+    GlyphAtlas(Texture&& texture, const GlyphContainerType& glyphs, int lineHeight);
+
+    /**
+     * Get a character's glyph, or null if it is not in the atlas.
+     */
+    const Glyph* getGlyph(char character) const;
+
+    /**
+     * Get the size of a single line of text, in pixels.
+     */
+    Vector2 measure(const std::string& text) const;
+
+    // --- Data Members
+    Texture texture;
+    GlyphContainerType glyphs;
+    int lineHeight;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, std::size_t Capacity = 32>
+class InplaceFunction;
+
+/**
+ * A move-only `std::function` that never allocates.
+ *
+ * The callable is stored inline, in `Capacity` bytes; one that doesn't fit is
+ * a compile error rather than a heap allocation. A lambda capturing `this`
+ * and a few references fits the default comfortably. Calling costs one
+ * indirect call, and the storage sits right next to the function pointer, so
+ * an array of these is walked without chasing pointers.
+ */
+template <typename Result, typename... Args, std::size_t Capacity>
+class InplaceFunction<Result(Args...), Capacity> {
+  public:
+    InplaceFunction() = default;
+
+    template <typename Callable>
+        requires(!std::is_same_v<std::decay_t<Callable>, InplaceFunction> &&
+                 std::is_invocable_r_v<Result, std::decay_t<Callable>&, Args...>)
+    InplaceFunction(Callable&& callable) {
+        using Stored = std::decay_t<Callable>;
+        static_assert(sizeof(Stored) <= Capacity,
+                      "Callable too large for InplaceFunction; raise Capacity");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t),
+                      "Callable over-aligned for InplaceFunction");
+        static_assert(std::is_nothrow_move_constructible_v<Stored>,
+                      "Callable must be nothrow move-constructible");
+
+        new (storage) Stored(std::forward<Callable>(callable));
+        invoker = &invoke<Stored>;
+        manager = &manage<Stored>;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept { moveFrom(other); }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&)            = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { reset(); }
+
+    /** Calling an empty `InplaceFunction` is undefined. */
+    Result operator()(Args... args) const {
+        return invoker(storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return invoker != nullptr; }
+
+    void reset() {
+        if (manager) {
+            manager(Operation::destroy, storage, nullptr);
+        }
+        invoker = nullptr;
+        manager = nullptr;
+    }
+
+  private:
+    enum class Operation { move, destroy };
+
+    using Invoker = Result (*)(void* storage, Args&&... args);
+    using Manager = void (*)(Operation operation, void* storage, void* source);
+
+    template <typename Stored>
+    static Result invoke(void* storage, Args&&... args) {
+        return (*static_cast<Stored*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Stored>
+    static void manage(Operation operation, void* storage, void* source) {
+        switch (operation) {
+        case Operation::move:
+            new (storage) Stored(std::move(*static_cast<Stored*>(source)));
+            static_cast<Stored*>(source)->~Stored();
+            break;
+        case Operation::destroy:
+            static_cast<Stored*>(storage)->~Stored();
+            break;
+        }
+    }
+
+    void moveFrom(InplaceFunction& other) {
+        if (other.manager) {
+            other.manager(Operation::move, storage, other.storage);
+        }
+        invoker       = other.invoker;
+        manager       = other.manager;
+        other.invoker = nullptr;
+        other.manager = nullptr;
+    }
+
+    Invoker invoker{nullptr};
+    Manager manager{nullptr};
+    alignas(std::max_align_t) mutable std::byte storage[Capacity];
+};
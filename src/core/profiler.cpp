@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+#include <SDL_timer.h>
+
+#include <spdlog/spdlog.h>
+
+#include "profiler.h"
+
+static const std::string TAG{"Profiler"};
+
+/** Guards the registry and thread names. */
+static std::mutex registryMutex;
+
+// -----------------------------------------------------------------------------
+// Zone
+// -----------------------------------------------------------------------------
+
+Profiler::Zone::Zone(const char* name)
+    : name{name}, start{SDL_GetPerformanceCounter()} {}
+
+Profiler::Zone::~Zone() { record(name, start, SDL_GetPerformanceCounter()); }
+
+// -----------------------------------------------------------------------------
+// Recording
+// -----------------------------------------------------------------------------
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end) {
+    Buffer& buffer{getThreadBuffer()};
+    const uint64_t count{buffer.count.load(std::memory_order_relaxed)};
+    buffer.events[count % capacity] = Event{name, start, end};
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    Buffer& buffer{getThreadBuffer()};
+    const std::lock_guard<std::mutex> lock{registryMutex};
+    buffer.threadName = name;
+}
+
+std::vector<std::shared_ptr<Profiler::Buffer>>& Profiler::getRegistry() {
+    static std::vector<std::shared_ptr<Buffer>> registry;
+    return registry;
+}
+
+Profiler::Buffer& Profiler::getThreadBuffer() {
+    thread_local std::shared_ptr<Buffer> buffer{[]() {
+        auto created{std::make_shared<Buffer>()};
+        created->events.resize(capacity);
+        const std::lock_guard<std::mutex> lock{registryMutex};
+        std::vector<std::shared_ptr<Buffer>>& registry{getRegistry()};
+        created->threadId = static_cast<uint32_t>(registry.size()) + 1;
+        registry.push_back(created);
+        return created;
+    }()};
+    return *buffer;
+}
+
+// -----------------------------------------------------------------------------
+// Export
+// -----------------------------------------------------------------------------
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+    std::FILE* file{std::fopen(path.c_str(), "w")};
+    if (!file) {
+        spdlog::error("{} Error: Could not open {} for writing!", TAG, path);
+        return false;
+    }
+
+    const std::lock_guard<std::mutex> lock{registryMutex};
+
+    // Timestamps are microseconds since the earliest event kept.
+    const double microsecondsPerTick{1e6 / SDL_GetPerformanceFrequency()};
+    uint64_t origin{UINT64_MAX};
+    for (const std::shared_ptr<Buffer>& entry : getRegistry()) {
+        const Buffer& buffer{*entry};
+        const uint64_t count{buffer.count.load(std::memory_order_acquire)};
+        const uint64_t kept{count < capacity ? count : capacity};
+        for (uint64_t idx = count - kept; idx < count; ++idx) {
+            origin = std::min(origin, buffer.events[idx % capacity].start);
+        }
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    const char* separator{""};
+    std::size_t written{0};
+    for (const std::shared_ptr<Buffer>& entry : getRegistry()) {
+        const Buffer& buffer{*entry};
+        if (!buffer.threadName.empty()) {
+            std::fprintf(file,
+                         "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                         "\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                         separator, buffer.threadId, buffer.threadName.c_str());
+            separator = ",";
+        }
+
+        const uint64_t count{buffer.count.load(std::memory_order_acquire)};
+        const uint64_t kept{count < capacity ? count : capacity};
+        for (uint64_t idx = count - kept; idx < count; ++idx) {
+            const Event& event{buffer.events[idx % capacity]};
+            std::fprintf(file,
+                         "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                         "\"ts\":%.3f,\"dur\":%.3f}",
+                         separator, event.name, buffer.threadId,
+                         (event.start - origin) * microsecondsPerTick,
+                         (event.end - event.start) * microsecondsPerTick);
+            separator = ",";
+            ++written;
+        }
+    }
+    std::fputs("\n]}\n", file);
+
+    const bool ok{std::fclose(file) == 0};
+    spdlog::info("{}: Wrote {} zones to {}.", TAG, written, path);
+    return ok;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Scoped-zone instrumentation for finding where frame time goes.
+ *
+ * `PROFILE_ZONE("Name")` times the rest of the enclosing scope. Every thread
+ * records into its own fixed-size ring buffer, so recording takes no locks
+ * and, once a buffer is full, keeps only the most recent zones. Zone names
+ * must be string literals (only the pointer is kept).
+ *
+ * `Profiler::exportChromeTrace` writes everything recorded as Chrome
+ * trace-event JSON, for chrome://tracing or https://ui.perfetto.dev. Export
+ * once the recording threads are quiet (e.g. at shutdown); buffers are
+ * read without synchronizing with their writers.
+ *
+ * Zones compile to nothing unless `PONG_PROFILE` is non-zero, which it is
+ * by default in debug builds only.
+ *
+ * TODO: Tests
+ */
+class Profiler {
+  public:
+    struct Event {
+        const char* name;
+        /** Performance counter values. */
+        uint64_t start;
+        uint64_t end;
+    };
+
+    /** Events kept per thread. */
+    static constexpr std::size_t capacity{1 << 16};
+
+    /**
+     * Times its own lifetime.
+     */
+    class Zone {
+      public:
+        explicit Zone(const char* name);
+        ~Zone();
+
+        Zone(const Zone&)            = delete;
+        Zone(Zone&&)                 = delete;
+        Zone& operator=(const Zone&) = delete;
+        Zone& operator=(Zone&&)      = delete;
+
+      private:
+        const char* name;
+        uint64_t start;
+    };
+
+    static void record(const char* name, uint64_t start, uint64_t end);
+
+    /**
+     * Label the calling thread in exported traces.
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * Write every recorded event to `path`. Returns false if the file
+     * couldn't be written.
+     */
+    static bool exportChromeTrace(const std::string& path);
+
+  private:
+    struct Buffer {
+        uint32_t threadId;
+        std::string threadName;
+        /** Total events ever recorded; the ring holds the last `capacity`. */
+        std::atomic<uint64_t> count{0};
+        std::vector<Event> events;
+    };
+
+    /** Buffers outlive their threads (pool workers come and go). */
+    static std::vector<std::shared_ptr<Buffer>>& getRegistry();
+    static Buffer& getThreadBuffer();
+};
+
+#ifndef PONG_PROFILE
+#ifdef NDEBUG
+#define PONG_PROFILE 0
+#else
+#define PONG_PROFILE 1
+#endif
+#endif
+
+#if PONG_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name)                                                         \
+    const Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__) { name }
+#else
+#define PROFILE_ZONE(name) (void)0
+#endif
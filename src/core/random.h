@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Small, fast, seedable pseudo-random number generator (xoshiro128**).
+ *
+ * Meant to be owned by whatever it serves, one per simulation, rather than
+ * shared: there is no global state and no locking, and the same seed always
+ * gives the same sequence on every machine. Not for anything
+ * security-related.
+ *
+ * The 128-bit state is filled from the 64-bit seed with SplitMix64, so
+ * nearby seeds (0, 1, 2, ...) still give unrelated sequences.
+ *
+ * TODO: Tests
+ */
+class Random {
+  public:
+    constexpr explicit Random(uint64_t seed = 0) { reseed(seed); }
+
+    /** Restart the sequence from `seed`. */
+    constexpr void reseed(uint64_t seed) {
+        for (uint32_t& word : state) {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t mixed{seed};
+            mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111eb;
+            word  = static_cast<uint32_t>((mixed ^ (mixed >> 31)) >> 32);
+        }
+    }
+
+    /** Uniform over all 32-bit values. */
+    constexpr uint32_t next() {
+        const uint32_t result{rotate(state[1] * 5, 7) * 9};
+        const uint32_t shifted{state[1] << 9};
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotate(state[3], 11);
+        return result;
+    }
+
+    /**
+     * Uniform in [0, `bound`), by multiply-and-shift instead of division
+     * (Lemire). Biased by at most `bound` / 2^32, which is fine for games.
+     */
+    constexpr uint32_t nextBelow(uint32_t bound) {
+        return static_cast<uint32_t>((uint64_t{next()} * bound) >> 32);
+    }
+
+    /** Uniform in [0, 1), on a 2^-24 grid. */
+    constexpr float nextFloat() { return (next() >> 8) * (1.0f / (1u << 24)); }
+
+    /** Uniform in [-1, 1). */
+    constexpr float nextSignedFloat() { return 2 * nextFloat() - 1; }
+
+    constexpr bool nextBool() { return next() >> 31; }
+
+  private:
+    uint32_t state[4]{};
+
+    static constexpr uint32_t rotate(uint32_t value, int bits) {
+        return (value << bits) | (value >> (32 - bits));
+    }
+};
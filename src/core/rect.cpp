@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 #include "rect.h"
@@ -99,3 +100,48 @@ Rect::Edge Rect::getIntersectingEdge(const Rect& other) const {
 
     return Edge::none; // Not intersecting
 }
+
+Rect::Impact Rect::getSweptImpact(const Rect& other,
+                                  const Vector2& displacement) const {
+    static const Impact miss{1, Edge::none};
+
+    // `other` overlaps `this` after moving by `t * displacement` whenever
+    // that point lies within the Minkowski difference, so this is a ray cast
+    // from the origin against the difference (the "slab" test).
+    const Rect minkowski{minkowskiDifference(other)};
+    if (minkowski.hasPoint(0, 0)) {
+        return miss;
+    }
+
+    float entry{0};
+    float exit{1};
+    const auto clipSlab = [&](int low, int high, int direction) {
+        if (direction == 0) {
+            // Never moves along this axis; it must already be inside.
+            return low < 0 && 0 < high;
+        }
+        const float enter{static_cast<float>(direction > 0 ? low : high) / direction};
+        const float leave{static_cast<float>(direction > 0 ? high : low) / direction};
+        entry = std::max(entry, enter);
+        exit  = std::min(exit, leave);
+        return entry < exit;
+    };
+    if (!clipSlab(minkowski.x, minkowski.x + minkowski.w, displacement.x) ||
+        !clipSlab(minkowski.y, minkowski.y + minkowski.h, displacement.y) ||
+        entry >= 1) {
+        return miss;
+    }
+
+    // Nudge `other` just past the point of contact, then let the discrete
+    // test name the edge it went through.
+    const auto step = [](int value) { return (value > 0) - (value < 0); };
+    const Rect contact{
+        other.x + static_cast<int>(std::round(displacement.x * entry)) +
+            step(displacement.x),
+        other.y + static_cast<int>(std::round(displacement.y * entry)) +
+            step(displacement.y),
+        other.w,
+        other.h,
+    };
+    return Impact{entry, getIntersectingEdge(contact)};
+}
@@ -70,4 +70,24 @@ struct Rect : public SDL_Rect {
      * collisions.
      */
     Edge getIntersectingEdge(const Rect& other) const;
+
+    /**
+     * Result of a swept collision test.
+     */
+    struct Impact {
+        /** Fraction of the displacement travelled before contact, in [0, 1). */
+        float time;
+        /** Edge of `this` that was hit. `Edge::none` if nothing was hit. */
+        Edge edge;
+    };
+
+    /**
+     * Swept ("continuous") version of `getIntersectingEdge`: find when, and
+     * through which edge of `this`, the `other` Rect first overlaps `this`
+     * while moving by `displacement`. `this` is taken to be stationary.
+     *
+     * Rects overlapping from the start are not impacts (they are left for
+     * discrete tests), nor are ones only touching at the very end.
+     */
+    Impact getSweptImpact(const Rect& other, const Vector2& displacement) const;
 };
@@ -1,14 +1,19 @@
+#include <algorithm>
+#include <array>
+#include <string_view>
+
 #include <spdlog/spdlog.h>
 
+#include "color.h"
 #include "display.h"
 #include "font.h"
+#include "glyph_atlas.h"
+#include "profiler.h"
 #include "renderer.h"
 #include "texture.h"
 
 static const std::string TAG{"Renderer"};
 
-// TODO: Support texture asset caching (including strings from fonts)
-
 // -----------------------------------------------------------------------------
 // No-op Constructor / Destructor
 // -----------------------------------------------------------------------------
@@ -21,21 +26,50 @@ Renderer::~Renderer() {}
 // -----------------------------------------------------------------------------
 
 void Renderer::initialize(const Config& config) {
-    (void)config;
     spdlog::info("Initializing {}.", TAG);
     if (!Display::get().window) {
         spdlog::error("{} Error: Window required by renderer is null!", TAG);
     }
-    renderer = SDL_CreateRenderer(Display::get().window, 0, 0);
+    uint32_t flags{config.vsync ? SDL_RENDERER_PRESENTVSYNC : 0u};
+    renderer = SDL_CreateRenderer(Display::get().window, 0, flags);
     if (!renderer) {
         spdlog::error("{} Error: Renderer create failed!", TAG);
         abort();
     }
+    textureCache.setBudget(config.textureCacheBytes);
+
+    // --- Offscreen Target
+    if (config.partialRedraw || (config.logicalWidth && config.logicalHeight)) {
+        int w{static_cast<int>(config.logicalWidth)};
+        int h{static_cast<int>(config.logicalHeight)};
+        if (!w || !h) {
+            SDL_GetRendererOutputSize(renderer, &w, &h);
+        }
+        scene = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                  SDL_TEXTUREACCESS_TARGET, w, h);
+        if (scene) {
+            // Whole-factor scaling stays crisp with nearest-pixel sampling.
+            SDL_SetTextureScaleMode(scene, SDL_ScaleModeNearest);
+            sceneBounds = SDL_Rect{0, 0, w, h};
+            isPartial   = config.partialRedraw;
+        } else {
+            spdlog::warn("{} Warning: No render target ({}), drawing to the window.",
+                         TAG, SDL_GetError());
+        }
+    }
     spdlog::debug("Initialized {} OK!", TAG);
 }
 
 void Renderer::terminate() {
     spdlog::info("Terminating {}.", TAG);
+    const TextureCache::Statistics& stats{textureCache.getStatistics()};
+    spdlog::info("{} texture cache: {} hits, {} misses, {} evictions.", TAG, stats.hits,
+                 stats.misses, stats.evictions);
+    textureCache.clear();
+    if (scene) {
+        SDL_DestroyTexture(scene);
+        scene = nullptr;
+    }
     SDL_DestroyRenderer(renderer);
 }
 
@@ -56,25 +90,324 @@ const Renderer& Renderer::get() { return getMutable(); }
 // -----------------------------------------------------------------------------
 
 void Renderer::clear() const {
+    discard();
+    records.clear();
+    // The scene is cleared as it is redrawn, see `showScene`.
+    if (scene) {
+        return;
+    }
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
     SDL_RenderClear(renderer);
+    countDraw(nullptr);
+}
+void Renderer::show() const {
+    PROFILE_ZONE("Renderer::show");
+    if (scene) {
+        showScene();
+        return;
+    }
+    flush();
+    {
+        PROFILE_ZONE("Renderer::present");
+        SDL_RenderPresent(renderer);
+    }
+    isPresented = true;
 }
-void Renderer::show() const { SDL_RenderPresent(renderer); }
+
+bool Renderer::didPresent() const { return isPresented; }
+
+void Renderer::invalidate() const { isInvalidated = true; }
 
 // -----------------------------------------------------------------------------
-// Draw
+// Draw (recorded, see `flush`)
 // -----------------------------------------------------------------------------
 
+// Fold `value` into `hash` (the SplitMix64 finalizer over a running sum).
+static uint64_t mixKey(uint64_t hash, uint64_t value) {
+    uint64_t z{hash + value + 0x9e3779b97f4a7c15};
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static uint64_t getPointerKey(const void* pointer) {
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+}
+
+static uint32_t getColorKey(const SDL_Color& color) {
+    return (uint32_t{color.r} << 24) | (uint32_t{color.g} << 16) |
+           (uint32_t{color.b} << 8) | uint32_t{color.a};
+}
+
+/**
+ * Index of `key` in `seen`, appending it if new. Materials per frame are
+ * few, so a linear search beats hashing.
+ */
+template <typename Key>
+static uint32_t getGroup(std::vector<Key>& seen, Key key) {
+    for (std::size_t idx = 0; idx < seen.size(); ++idx) {
+        if (seen[idx] == key) {
+            return static_cast<uint32_t>(idx);
+        }
+    }
+    seen.push_back(key);
+    return static_cast<uint32_t>(seen.size() - 1);
+}
+
 void Renderer::drawRect(const SDL_Rect& rect, const SDL_Color& color) const {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderFillRect(renderer, &rect);
+    fills.push_back({getGroup(fillColors, getColorKey(color)), color, rect});
+    record(rect, mixKey(0, getColorKey(color)));
 }
 
 void Renderer::drawTexture(const Texture& texture, int x, int y) const {
     int cx{x - (texture.w / 2)};
     int cy{y - (texture.h / 2)};
-    SDL_Rect rect{cx, cy, texture.w, texture.h};
-    SDL_RenderCopy(renderer, texture.data, NULL, &rect);
+    uint8_t alpha{255};
+    SDL_GetTextureAlphaMod(texture.data, &alpha);
+    const SDL_Rect destination{cx, cy, texture.w, texture.h};
+    copies.push_back({getGroup(copyTextures, texture.data), texture.data, alpha,
+                      destination});
+    record(destination, mixKey(mixKey(1, getPointerKey(texture.data)), alpha));
+}
+
+void Renderer::drawText(const GlyphAtlas& atlas, const std::string& text, int x,
+                        int y, const SDL_Color& color) const {
+    const Vector2 size{atlas.measure(text)};
+    const float inverseWidth{1.0f / atlas.texture.w};
+    const float inverseHeight{1.0f / atlas.texture.h};
+    float penX{static_cast<float>(x - (size.x / 2))};
+    const float top{static_cast<float>(y - (size.y / 2))};
+
+    uint64_t key{mixKey(2, getPointerKey(atlas.texture.data))};
+    key = mixKey(key, getColorKey(color));
+    key = mixKey(key, std::hash<std::string_view>{}(text));
+    record(SDL_Rect{static_cast<int>(penX), static_cast<int>(top),
+                    static_cast<int>(size.x), static_cast<int>(size.y)},
+           key);
+
+    GeometryBatch& batch{getBatch(atlas.texture.data)};
+    for (char character : text) {
+        const GlyphAtlas::Glyph* glyph{atlas.getGlyph(character)};
+        if (!glyph) {
+            continue;
+        }
+        const SDL_Rect& source{glyph->source};
+        const float left{source.x * inverseWidth};
+        const float right{(source.x + source.w) * inverseWidth};
+        const float upper{source.y * inverseHeight};
+        const float lower{(source.y + source.h) * inverseHeight};
+        const float w{static_cast<float>(source.w)};
+        const float h{static_cast<float>(source.h)};
+
+        const int first{static_cast<int>(batch.vertices.size())};
+        batch.vertices.push_back({{penX, top}, color, {left, upper}});
+        batch.vertices.push_back({{penX + w, top}, color, {right, upper}});
+        batch.vertices.push_back({{penX + w, top + h}, color, {right, lower}});
+        batch.vertices.push_back({{penX, top + h}, color, {left, lower}});
+        for (int corner : {0, 1, 2, 0, 2, 3}) {
+            batch.indices.push_back(first + corner);
+        }
+        penX += glyph->advance;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Command Buffer
+// -----------------------------------------------------------------------------
+
+void Renderer::flush() const {
+    submit();
+    discard();
+}
+
+void Renderer::submit() const {
+    PROFILE_ZONE("Renderer::submit");
+    // --- Fills, one call per color, colors in order of first use
+    std::stable_sort(fills.begin(), fills.end(),
+                     [](const FillCommand& a, const FillCommand& b) {
+                         return a.group < b.group;
+                     });
+    for (auto run = fills.begin(); run != fills.end();) {
+        const SDL_Color color{run->color};
+        const uint32_t group{run->group};
+        rects.clear();
+        for (; run != fills.end() && run->group == group; ++run) {
+            rects.push_back(run->rect);
+        }
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRects(renderer, rects.data(), static_cast<int>(rects.size()));
+        countDraw(nullptr);
+    }
+
+    // --- Textures, grouped to avoid re-binding, in order of first use
+    std::stable_sort(copies.begin(), copies.end(),
+                     [](const CopyCommand& a, const CopyCommand& b) {
+                         return a.group < b.group;
+                     });
+    for (const CopyCommand& copy : copies) {
+        SDL_SetTextureAlphaMod(copy.texture, copy.alpha);
+        SDL_RenderCopy(renderer, copy.texture, NULL, &copy.destination);
+        countDraw(copy.texture);
+    }
+
+    // --- Text, one call per atlas
+    for (const GeometryBatch& batch : batches) {
+        if (!batch.indices.empty()) {
+            SDL_RenderGeometry(renderer, batch.texture, batch.vertices.data(),
+                               static_cast<int>(batch.vertices.size()),
+                               batch.indices.data(),
+                               static_cast<int>(batch.indices.size()));
+            countDraw(batch.texture);
+        }
+    }
+}
+
+void Renderer::discard() const {
+    fills.clear();
+    copies.clear();
+    fillColors.clear();
+    copyTextures.clear();
+    for (GeometryBatch& batch : batches) {
+        batch.vertices.clear();
+        batch.indices.clear();
+    }
+}
+
+void Renderer::countDraw(SDL_Texture* texture) const {
+    ++counters.drawCalls;
+    if (texture && texture != boundTexture) {
+        ++counters.textureBinds;
+        boundTexture = texture;
+    }
+}
+
+Renderer::GeometryBatch& Renderer::getBatch(SDL_Texture* texture) const {
+    // Only ever a handful of atlases; a linear search beats hashing.
+    for (GeometryBatch& batch : batches) {
+        if (batch.texture == texture) {
+            return batch;
+        }
+    }
+    return batches.emplace_back(GeometryBatch{texture, {}, {}});
+}
+
+// -----------------------------------------------------------------------------
+// Offscreen Target / Partial Redraw
+// -----------------------------------------------------------------------------
+
+void Renderer::record(const SDL_Rect& bounds, uint64_t key) const {
+    if (isPartial) {
+        records.push_back({bounds, key});
+    }
+}
+
+void Renderer::collectDirtyRects() const {
+    dirtyRects.clear();
+    if (isInvalidated || !isPartial) {
+        dirtyRects.push_back(sceneBounds);
+        return;
+    }
+
+    // Pairwise by position: a draw inserted or removed mid-frame dirties
+    // everything after it, which is wasteful but never wrong.
+    const std::size_t common{std::min(records.size(), previousRecords.size())};
+    for (std::size_t i = 0; i < common; ++i) {
+        const DrawRecord& current{records[i]};
+        const DrawRecord& previous{previousRecords[i]};
+        if (current.key != previous.key ||
+            !SDL_RectEquals(&current.bounds, &previous.bounds)) {
+            addDirtyRect(current.bounds);
+            addDirtyRect(previous.bounds);
+        }
+    }
+    for (std::size_t i = common; i < records.size(); ++i) {
+        addDirtyRect(records[i].bounds);
+    }
+    for (std::size_t i = common; i < previousRecords.size(); ++i) {
+        addDirtyRect(previousRecords[i].bounds);
+    }
+}
+
+void Renderer::addDirtyRect(const SDL_Rect& rect) const {
+    SDL_Rect clipped;
+    if (!SDL_IntersectRect(&rect, &sceneBounds, &clipped)) {
+        return;
+    }
+
+    // Merge into the first rect it overlaps, or into the last one once
+    // there are enough of them.
+    for (SDL_Rect& dirty : dirtyRects) {
+        if (SDL_HasIntersection(&dirty, &clipped)) {
+            SDL_UnionRect(&dirty, &clipped, &dirty);
+            return;
+        }
+    }
+    if (dirtyRects.size() < maxDirtyRects) {
+        dirtyRects.push_back(clipped);
+    } else {
+        SDL_UnionRect(&dirtyRects.back(), &clipped, &dirtyRects.back());
+    }
+}
+
+void Renderer::showScene() const {
+    collectDirtyRects();
+    std::swap(records, previousRecords);
+    records.clear();
+
+    if (dirtyRects.empty()) {
+        discard();
+        isPresented = false;
+        return;
+    }
+
+    // --- Recomposite the dirty rects into the scene
+    // Every command is replayed for every rect; the clip rect discards the
+    // rest. Commands are few, fill rate is what this saves.
+    SDL_SetRenderTarget(renderer, scene);
+    for (const SDL_Rect& dirty : dirtyRects) {
+        SDL_RenderSetClipRect(renderer, &dirty);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderFillRect(renderer, &dirty);
+        countDraw(nullptr);
+        submit();
+    }
+    SDL_RenderSetClipRect(renderer, NULL);
+    SDL_SetRenderTarget(renderer, NULL);
+    discard();
+
+    // --- Present the whole scene, scaled
+    const SDL_Rect destination{getPresentRect()};
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, scene, NULL, &destination);
+    countDraw(nullptr);
+    countDraw(scene);
+    {
+        PROFILE_ZONE("Renderer::present");
+        SDL_RenderPresent(renderer);
+    }
+    isInvalidated = false;
+    isPresented   = true;
+}
+
+SDL_Rect Renderer::getPresentRect() const {
+    int outputWidth{0};
+    int outputHeight{0};
+    SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+
+    // Largest whole factor that fits. A window smaller than the logical
+    // size can't fit any, so the scene is shrunk to fit instead.
+    const int scale{
+        std::min(outputWidth / sceneBounds.w, outputHeight / sceneBounds.h)};
+    int w{sceneBounds.w * scale};
+    int h{sceneBounds.h * scale};
+    if (scale < 1) {
+        const float fit{std::min(static_cast<float>(outputWidth) / sceneBounds.w,
+                                 static_cast<float>(outputHeight) / sceneBounds.h)};
+        w = static_cast<int>(sceneBounds.w * fit);
+        h = static_cast<int>(sceneBounds.h * fit);
+    }
+    return SDL_Rect{(outputWidth - w) / 2, (outputHeight - h) / 2, w, h};
 }
 
 // -----------------------------------------------------------------------------
@@ -85,6 +418,66 @@ Texture Renderer::loadTexture(const Font& font, const std::string& text,
                               const SDL_Color& color) const {
     SDL_Surface* surface = TTF_RenderText_Solid(font.get(), text.c_str(), color);
     Texture texture{SDL_CreateTextureFromSurface(Renderer::get().renderer, surface)};
+    ++counters.textureUploads;
     SDL_FreeSurface(surface);
     return texture;
 }
+
+std::shared_ptr<Texture> Renderer::getTexture(const Font& font,
+                                             const std::string& text,
+                                             const SDL_Color& color) const {
+    return textureCache.get(font, text, color,
+                            [&]() { return loadTexture(font, text, color); });
+}
+
+const TextureCache::Statistics& Renderer::getTextureCacheStatistics() const {
+    return textureCache.getStatistics();
+}
+
+const Renderer::Counters& Renderer::getCounters() const { return counters; }
+
+GlyphAtlas Renderer::loadGlyphAtlas(const Font& font) const {
+    // Wide enough for a row or two of glyphs at typical sizes, and well
+    // within every renderer's texture size limit.
+    static const int atlasWidth{512};
+
+    const SDL_Color white{Color::white()};
+    const int lineHeight{TTF_FontHeight(font.get())};
+
+    // Rasterize each glyph and lay the cells out in rows ("shelves").
+    GlyphAtlas::GlyphContainerType glyphs{};
+    std::array<SDL_Surface*, GlyphAtlas::count> surfaces{};
+    int penX{0};
+    int penY{0};
+    for (std::size_t index = 0; index < glyphs.size(); ++index) {
+        const char character{static_cast<char>(GlyphAtlas::first + index)};
+        SDL_Surface* surface{TTF_RenderGlyph_Solid(font.get(), character, white)};
+        int advance{0};
+        TTF_GlyphMetrics(font.get(), character, NULL, NULL, NULL, NULL, &advance);
+
+        const int w{surface ? surface->w : 0};
+        const int h{surface ? surface->h : 0};
+        if (penX + w > atlasWidth) {
+            penX = 0;
+            penY += lineHeight;
+        }
+        glyphs[index]   = {{penX, penY, w, h}, advance};
+        surfaces[index] = surface;
+        penX += w;
+    }
+
+    SDL_Surface* atlas{SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, penY + lineHeight,
+                                                      32, SDL_PIXELFORMAT_RGBA32)};
+    for (std::size_t index = 0; index < surfaces.size(); ++index) {
+        if (surfaces[index]) {
+            SDL_Rect destination{glyphs[index].source};
+            SDL_BlitSurface(surfaces[index], NULL, atlas, &destination);
+            SDL_FreeSurface(surfaces[index]);
+        }
+    }
+
+    Texture texture{SDL_CreateTextureFromSurface(renderer, atlas)};
+    ++counters.textureUploads;
+    SDL_FreeSurface(atlas);
+    return GlyphAtlas{std::move(texture), glyphs, lineHeight};
+}
@@ -1,18 +1,88 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "SDL_rect.h"
 #include "SDL_render.h"
 
 #include "display.h"
 #include "font.h"
+#include "glyph_atlas.h"
 #include "texture.h"
+#include "texture_cache.h"
 
-// TODO: Tests
+/**
+ * Draws are not submitted as they are made. They are recorded into a
+ * frame-scoped command buffer and flushed at `show`, grouped by "material"
+ * so that the number of SDL draw calls grows with the number of distinct
+ * colors and textures rather than with the number of things drawn:
+ *
+ * 1. Filled rects, one `SDL_RenderFillRects` per color.
+ * 2. Textures, grouped by texture.
+ * 3. Text, one `SDL_RenderGeometry` per glyph atlas.
+ *
+ * Within a group, draws keep the order they were made in, and groups of a
+ * kind are drawn in the order of their first draw this frame (never by
+ * pointer or color value), so a frame always comes out the same. Across
+ * kinds the order above wins: text is always over textures, which are
+ * always over rects. Overlapping draws of different colors (or textures)
+ * therefore stack by first use, not by call order; draws that must stack
+ * by call order should share a color or texture.
+ *
+ * With a logical size (`Config::logicalWidth`, `Config::logicalHeight`),
+ * frames are composed in an offscreen render target of that size, then
+ * presented with a single scaled copy: by the largest whole factor that
+ * fits the window, centered, with black bars around it. Draw coordinates
+ * are logical, whatever the window size, and fill rate depends on the
+ * logical size alone.
+ *
+ * With `Config::partialRedraw`, the same target persists between frames.
+ * Each frame's draws are compared with the last frame's, and only the
+ * rectangles they differ in are cleared and redrawn into the target. A
+ * frame identical to the last is not presented at all.
+ *
+ * Text textures are cached by content (see `TextureCache`); prefer
+ * `getTexture` to `loadTexture` for text that is drawn more than once.
+ *
+ * TODO: Tests
+ */
 class Renderer {
     friend class App;
 
   public:
-    struct Config {};
+    struct Config {
+        /** Block `show` on the display's vertical refresh. */
+        bool vsync{false};
+        /** Budget for cached text textures, estimated at 4 bytes per pixel. */
+        std::size_t textureCacheBytes{8 * 1024 * 1024};
+        /**
+         * Redraw only what changed since the last frame (see above). Falls
+         * back to full redraws if render targets are unavailable.
+         */
+        bool partialRedraw{false};
+        /**
+         * Size drawn at, scaled up to the window when presented. Zero
+         * (the default) draws at the window's size, unscaled.
+         */
+        unsigned int logicalWidth{0};
+        unsigned int logicalHeight{0};
+    };
+
+    /**
+     * Running totals of work submitted to SDL, for `FrameStats`.
+     */
+    struct Counters {
+        /** `SDL_Render*` calls that draw (clears, fills, copies, geometry). */
+        uint64_t drawCalls{0};
+        /** Draw calls with a different texture than the previous one. */
+        uint64_t textureBinds{0};
+        /** Textures created from surfaces (`loadTexture`, atlases). */
+        uint64_t textureUploads{0};
+    };
 
     ~Renderer();
 
@@ -23,14 +93,108 @@ class Renderer {
 
     void clear() const;
     void show() const;
+    /**
+     * Did the last `show` present a frame? Only ever false with
+     * `Config::partialRedraw`, when nothing changed.
+     */
+    bool didPresent() const;
+    /**
+     * Redraw and present the whole of the next frame, e.g. after the window
+     * was exposed or render target contents were lost.
+     */
+    void invalidate() const;
     void drawRect(const SDL_Rect& rect, const SDL_Color& color) const;
     // TODO: Support Vector2 positioning
     void drawTexture(const Texture& texture, int x, int y) const;
+    /** Draw a line of text centered on `x`, `y`, as one batch of quads. */
+    void drawText(const GlyphAtlas& atlas, const std::string& text, int x, int y,
+                  const SDL_Color& color) const;
     Texture loadTexture(const Font& font, const std::string& text,
                         const SDL_Color& color) const;
+    GlyphAtlas loadGlyphAtlas(const Font& font) const;
+    /** Get a shared, cached texture of `text`, loading it on first use. */
+    std::shared_ptr<Texture> getTexture(const Font& font, const std::string& text,
+                                        const SDL_Color& color) const;
+    const TextureCache::Statistics& getTextureCacheStatistics() const;
+    const Counters& getCounters() const;
 
   private:
     SDL_Renderer* renderer;
+    /** Budget set by `initialize`. */
+    mutable TextureCache textureCache{0};
+    mutable Counters counters;
+    /** Last texture drawn with, to count binds. */
+    mutable SDL_Texture* boundTexture{nullptr};
+
+    // --- Frame Command Buffer
+    // Recorded by the draw functions, flushed by `show`, and discarded by
+    // `clear`. Buffers keep their capacity from frame to frame.
+
+    struct FillCommand {
+        /** Order of this color's first fill this frame; what fills sort by. */
+        uint32_t group;
+        SDL_Color color;
+        SDL_Rect rect;
+    };
+
+    struct CopyCommand {
+        /** Order of this texture's first copy this frame; what copies sort by. */
+        uint32_t group;
+        SDL_Texture* texture;
+        /** Texture alpha modulation when the draw was made. */
+        uint8_t alpha;
+        SDL_Rect destination;
+    };
+
+    struct GeometryBatch {
+        SDL_Texture* texture;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    mutable std::vector<FillCommand> fills;
+    mutable std::vector<CopyCommand> copies;
+    mutable std::vector<GeometryBatch> batches;
+    mutable std::vector<SDL_Rect> rects;
+    /** Colors and textures in order of first use this frame (see groups). */
+    mutable std::vector<uint32_t> fillColors;
+    mutable std::vector<SDL_Texture*> copyTextures;
+
+    void flush() const;
+    void submit() const;
+    void discard() const;
+    GeometryBatch& getBatch(SDL_Texture* texture) const;
+    void countDraw(SDL_Texture* texture) const;
+
+    // --- Offscreen Target / Partial Redraw
+    // Every draw is also summarized as a record: where it lands, and a key
+    // for what it looks like. A record that differs from the one at the
+    // same position last frame dirties both of their bounds.
+
+    struct DrawRecord {
+        SDL_Rect bounds;
+        uint64_t key;
+    };
+
+    /** Beyond this many, dirty rects are merged into one another. */
+    static constexpr std::size_t maxDirtyRects{4};
+
+    /** Offscreen frame. Null when drawing straight to the window. */
+    SDL_Texture* scene{nullptr};
+    /** The logical size. */
+    SDL_Rect sceneBounds{0, 0, 0, 0};
+    bool isPartial{false};
+    mutable std::vector<DrawRecord> records;
+    mutable std::vector<DrawRecord> previousRecords;
+    mutable std::vector<SDL_Rect> dirtyRects;
+    mutable bool isInvalidated{true};
+    mutable bool isPresented{false};
+
+    void record(const SDL_Rect& bounds, uint64_t key) const;
+    void collectDirtyRects() const;
+    void addDirtyRect(const SDL_Rect& rect) const;
+    void showScene() const;
+    SDL_Rect getPresentRect() const;
 
     static Renderer& getMutable();
 
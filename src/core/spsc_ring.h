@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Fixed-capacity, lock-free, single-producer single-consumer ring buffer.
+ *
+ * One thread may `push` while another `pop`s, with no locks and no
+ * allocation; `Capacity` must be a power of two. Head and tail are
+ * free-running counters on separate cache lines, so the two sides only
+ * share a line when one of them reads the other's counter.
+ *
+ * Each side also keeps a cached copy of the other side's counter and only
+ * reloads it when the ring looks full (producer) or empty (consumer).
+ */
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+  public:
+    /**
+     * Producer only. Returns false (and drops nothing) if the ring is full.
+     */
+    bool push(const T& value) {
+        const std::size_t tail{producer.tail.load(std::memory_order_relaxed)};
+        if (tail - producer.cachedHead == Capacity) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cachedHead == Capacity) {
+                return false;
+            }
+        }
+        slots[tail & mask] = value;
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Returns the oldest value, or null if the ring is empty.
+     * The pointer stays valid until the next `pop`.
+     */
+    const T* peek() {
+        const std::size_t head{consumer.head.load(std::memory_order_relaxed)};
+        if (head == consumer.cachedTail) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cachedTail) {
+                return nullptr;
+            }
+        }
+        return &slots[head & mask];
+    }
+
+    /**
+     * Consumer only. Discards the value `peek` returned.
+     */
+    void pop() {
+        consumer.head.store(consumer.head.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_release);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+  private:
+    static constexpr std::size_t mask{Capacity - 1};
+    static constexpr std::size_t lineSize{64};
+
+    struct alignas(lineSize) Producer {
+        std::atomic<std::size_t> tail{0};
+        std::size_t cachedHead{0};
+    };
+    struct alignas(lineSize) Consumer {
+        std::atomic<std::size_t> head{0};
+        std::size_t cachedTail{0};
+    };
+
+    Producer producer;
+    Consumer consumer;
+    std::array<T, Capacity> slots{};
+};
@@ -12,7 +12,8 @@ struct MyApp : public App {
     MyApp() : App({.headless = true}) {}
     ~MyApp() {}
     void processEvent(const SDL_Event& event) { (void)event; }
-    void processFrame(float delta) { (void)delta; }
+    void simulate(float delta) { (void)delta; }
+    void render(float alpha) { (void)alpha; }
 };
 
 /**
@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <initializer_list>
+
+#include "core/fixed.h"
+#include "core/tests/test.h"
+
+/**
+ * `Fixed` rounding, multiply/divide range, and float round trips. The
+ * simulation's determinism rests on these staying exactly as they are.
+ */
+
+static Fixed half(int numerator) {
+    return Fixed::fromRaw(numerator * (Fixed::one / 2));
+}
+
+int main() {
+    // --- toInt rounds to nearest, halves up (towards positive infinity)
+    CHECK(half(1).toInt() == 1);   //  0.5
+    CHECK(half(3).toInt() == 2);   //  1.5
+    CHECK(half(-1).toInt() == 0);  // -0.5
+    CHECK(half(-3).toInt() == -1); // -1.5
+    CHECK(half(-5).toInt() == -2); // -2.5
+    // Just either side of a half
+    CHECK(Fixed::fromRaw(Fixed::one / 2 - 1).toInt() == 0);
+    CHECK(Fixed::fromRaw(-Fixed::one / 2 - 1).toInt() == -1);
+    CHECK(Fixed::fromRaw(-Fixed::one / 2 + 1).toInt() == 0);
+    // Whole numbers are exact, across the documented range
+    for (int value : {0, 1, -1, 255, -255, 32767, -32767}) {
+        CHECK(Fixed::fromInt(value).toInt() == value);
+    }
+
+    // --- Multiplication goes through 64 bits: no overflow mid-way
+    CHECK(Fixed::fromInt(181) * Fixed::fromInt(181) == Fixed::fromInt(32761));
+    CHECK(Fixed::fromInt(-200) * Fixed::fromInt(150) == Fixed::fromInt(-30000));
+    CHECK(Fixed::fromInt(-200) * Fixed::fromInt(-150) == Fixed::fromInt(30000));
+    CHECK(Fixed::fromInt(32767) * Fixed::fromInt(1) == Fixed::fromInt(32767));
+    // Sub-unit products truncate towards negative infinity (arithmetic shift)
+    const Fixed smallest{Fixed::fromRaw(1)};
+    CHECK(smallest * half(1) == Fixed::fromRaw(0));
+    CHECK(-smallest * half(1) == Fixed::fromRaw(-1));
+    CHECK(half(3) * half(-3) == Fixed::fromFloat(-2.25f));
+
+    // --- Division likewise, keeping the fraction
+    CHECK(Fixed::fromInt(32767) / Fixed::fromInt(1) == Fixed::fromInt(32767));
+    CHECK(Fixed::fromInt(30000) / Fixed::fromInt(-2) == Fixed::fromInt(-15000));
+    CHECK(Fixed::fromInt(1) / Fixed::fromInt(4) == Fixed::fromFloat(0.25f));
+    CHECK(Fixed::fromInt(-1) / Fixed::fromInt(4) == Fixed::fromFloat(-0.25f));
+    CHECK(Fixed::fromInt(16000) / half(1) == Fixed::fromInt(32000));
+    // Truncates towards zero (integer division)
+    CHECK(Fixed::fromInt(1) / Fixed::fromInt(3) == Fixed::fromRaw(21845));
+    CHECK(Fixed::fromInt(-1) / Fixed::fromInt(3) == Fixed::fromRaw(-21845));
+
+    // --- Float round trips
+    // Values on the 16.16 grid survive exactly
+    for (float value : {0.0f, 0.5f, -0.5f, 1.25f, -1.25f, 3.0517578125e-5f,
+                        -3.0517578125e-5f, 32767.0f, -32767.0f, 12345.671875f}) {
+        CHECK(Fixed::fromFloat(value).toFloat() == value);
+    }
+    // Anything else lands on the nearest grid point, halves away from zero
+    const float step{1.0f / Fixed::one};
+    for (float value : {0.1f, -0.1f, 3.14159f, -3.14159f, 1000.333f, -1000.333f}) {
+        const float error{Fixed::fromFloat(value).toFloat() - value};
+        CHECK(error <= step / 2 && error >= -step / 2);
+    }
+    CHECK(Fixed::fromFloat(step / 2).raw == 1);
+    CHECK(Fixed::fromFloat(-step / 2).raw == -1);
+
+    // --- Ordering and negation are those of the raw value
+    CHECK(Fixed::fromInt(-1) < half(-1));
+    CHECK(-half(3) == half(-3));
+    Fixed accumulator{};
+    for (int idx = 0; idx < 10; ++idx) {
+        accumulator += Fixed::fromFloat(0.1f);
+    }
+    // Sums are exact in fixed point: ten of the same step, every time
+    CHECK(accumulator == Fixed::fromRaw(10 * Fixed::fromFloat(0.1f).raw));
+
+    return finishTests();
+}
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <thread>
+
+#include "core/spsc_ring.h"
+#include "core/tests/test.h"
+
+/**
+ * `SpscRing` keeps order, reports full and empty exactly at the edges, and
+ * hands every value across threads intact and in order. Run under
+ * ThreadSanitizer (`-Db_sanitize=thread`) to check the memory ordering too.
+ */
+
+static void checkEdges() {
+    SpscRing<int, 4> ring;
+
+    // --- Empty
+    CHECK(ring.peek() == nullptr);
+
+    // --- Fill, then full
+    for (int value = 0; value < 4; ++value) {
+        CHECK(ring.push(value));
+    }
+    CHECK(!ring.push(4));
+    // Refusing a push drops nothing.
+    CHECK(ring.peek() && *ring.peek() == 0);
+
+    // --- Peek doesn't consume; pop does, oldest first
+    CHECK(ring.peek() && *ring.peek() == 0);
+    ring.pop();
+    CHECK(ring.push(4));
+    CHECK(!ring.push(5));
+    for (int value = 1; value <= 4; ++value) {
+        const int* front{ring.peek()};
+        CHECK(front && *front == value);
+        ring.pop();
+    }
+    CHECK(ring.peek() == nullptr);
+
+    // --- Wraps around many times without losing its place
+    for (int value = 0; value < 1000; ++value) {
+        CHECK(ring.push(value));
+        if (value % 3 == 0) {
+            CHECK(ring.push(-value));
+        }
+        const int* front{ring.peek()};
+        CHECK(front && *front == value);
+        ring.pop();
+        if (value % 3 == 0) {
+            front = ring.peek();
+            CHECK(front && *front == -value);
+            ring.pop();
+        }
+        CHECK(ring.peek() == nullptr);
+    }
+}
+
+static void checkThreads() {
+    // Small, so both sides keep running into full and empty.
+    SpscRing<uint64_t, 64> ring;
+    static const uint64_t count{1'000'000};
+
+    std::thread producer{[&ring]() {
+        for (uint64_t value = 0; value < count;) {
+            if (ring.push(value)) {
+                ++value;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    uint64_t expected{0};
+    uint64_t outOfOrder{0};
+    while (expected < count) {
+        const uint64_t* value{ring.peek()};
+        if (!value) {
+            std::this_thread::yield();
+            continue;
+        }
+        outOfOrder += *value != expected;
+        ++expected;
+        ring.pop();
+    }
+    producer.join();
+
+    CHECK(outOfOrder == 0);
+    CHECK(ring.peek() == nullptr);
+}
+
+int main() {
+    checkEdges();
+    checkThreads();
+
+    return finishTests();
+}
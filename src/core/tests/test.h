@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdio>
+
+/**
+ * Minimal unit-test harness.
+ *
+ * `CHECK(condition)` reports a failed condition (with its file and line) and
+ * carries on, so one run lists every failure. `finishTests` returns the exit
+ * status for `main`: non-zero if any check failed, which is what `meson test`
+ * looks at.
+ */
+
+inline unsigned int& getTestFailures() {
+    static unsigned int failures{0};
+    return failures;
+}
+
+inline void checkTest(bool condition, const char* expression, const char* file,
+                      int line) {
+    if (!condition) {
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+        ++getTestFailures();
+    }
+}
+
+#define CHECK(condition) checkTest(static_cast<bool>(condition), #condition, \
+                                   __FILE__, __LINE__)
+
+inline int finishTests() {
+    if (getTestFailures()) {
+        std::fprintf(stderr, "%u check(s) failed\n", getTestFailures());
+        return 1;
+    }
+    return 0;
+}
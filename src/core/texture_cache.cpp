@@ -0,0 +1,87 @@
+#include "texture_cache.h"
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+
+TextureCache::TextureCache(std::size_t budget) : budget{budget} {}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+TextureCache::Handle TextureCache::get(const Font& font, const std::string& text,
+                                       const SDL_Color& color, const Loader& load) {
+    Key key{
+        font.getPath(),
+        font.getPoints(),
+        text,
+        (uint32_t{color.r} << 24) | (uint32_t{color.g} << 16) |
+            (uint32_t{color.b} << 8) | uint32_t{color.a},
+    };
+
+    // --- Hit: move to the front
+    if (auto found{index.find(key)}; found != index.end()) {
+        ++statistics.hits;
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->texture;
+    }
+
+    // --- Miss: load, then make room
+    ++statistics.misses;
+    Handle texture{std::make_shared<Texture>(load())};
+    const std::size_t bytes{static_cast<std::size_t>(texture->w) * texture->h * 4};
+    entries.push_front({key, texture, bytes});
+    index.emplace(std::move(key), entries.begin());
+    statistics.bytes += bytes;
+    ++statistics.entries;
+    evict();
+    return texture;
+}
+
+void TextureCache::setBudget(std::size_t budget) {
+    this->budget = budget;
+    evict();
+}
+
+void TextureCache::clear() {
+    entries.clear();
+    index.clear();
+    statistics.bytes   = 0;
+    statistics.entries = 0;
+}
+
+const TextureCache::Statistics& TextureCache::getStatistics() const {
+    return statistics;
+}
+
+// -----------------------------------------------------------------------------
+// Private Methods
+// -----------------------------------------------------------------------------
+
+std::size_t TextureCache::KeyHash::operator()(const Key& key) const {
+    // Combine as in boost::hash_combine.
+    std::size_t hash{std::hash<std::string>{}(key.text)};
+    for (std::size_t part : {std::hash<std::string>{}(key.fontPath),
+                             std::hash<int>{}(key.fontPoints),
+                             std::hash<uint32_t>{}(key.color)}) {
+        hash ^= part + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+void TextureCache::evict() {
+    // Walk from least recently used, skipping entries still in use.
+    for (auto entry{entries.end()};
+         statistics.bytes > budget && entry != entries.begin();) {
+        --entry;
+        if (entry->texture.use_count() > 1) {
+            continue;
+        }
+        statistics.bytes -= entry->bytes;
+        --statistics.entries;
+        ++statistics.evictions;
+        index.erase(entry->key);
+        entry = entries.erase(entry);
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "SDL_pixels.h"
+
+#include "font.h"
+#include "texture.h"
+
+/**
+ * Text textures, keyed on what they show: font (file and size), text, and
+ * color. Asking twice for the same content hands out the same texture.
+ *
+ * Handles are shared; an entry is "in use" while any handle besides the
+ * cache's own is alive. Once the cached bytes exceed the budget, entries
+ * not in use are evicted, least recently used first. Entries in use are
+ * never evicted, so the budget can be exceeded while they are held.
+ *
+ * Sizes are estimated as 4 bytes per pixel.
+ *
+ * TODO: Tests
+ */
+class TextureCache {
+  public:
+    using Handle = std::shared_ptr<Texture>;
+    using Loader = std::function<Texture()>;
+
+    struct Statistics {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        /** Estimated size of every cached texture, in use or not. */
+        std::size_t bytes{0};
+        std::size_t entries{0};
+    };
+
+    TextureCache(std::size_t budget);
+
+    TextureCache(const TextureCache&)            = delete;
+    TextureCache(TextureCache&&)                 = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+    TextureCache& operator=(TextureCache&&)      = delete;
+
+    /**
+     * Get the texture for this content, calling `load` to create it only if
+     * it is not cached.
+     */
+    Handle get(const Font& font, const std::string& text, const SDL_Color& color,
+               const Loader& load);
+
+    /**
+     * Change the byte budget, evicting as needed.
+     */
+    void setBudget(std::size_t budget);
+
+    /**
+     * Drop every entry. Outstanding handles stay valid.
+     */
+    void clear();
+
+    const Statistics& getStatistics() const;
+
+  private:
+    struct Key {
+        std::string fontPath;
+        int fontPoints;
+        std::string text;
+        uint32_t color;
+
+        bool operator==(const Key& rhs) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        Handle texture;
+        std::size_t bytes;
+    };
+
+    /** Most recently used at the front. */
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    std::size_t budget;
+    Statistics statistics;
+
+    void evict();
+};
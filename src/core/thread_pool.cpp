@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <string>
+
+#include "profiler.h"
+#include "thread_pool.h"
+
+// -----------------------------------------------------------------------------
+// Constructor / Destructor
+// -----------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    workers.reserve(threadCount);
+    for (std::size_t idx = 0; idx < threadCount; ++idx) {
+        workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    // Only start threads once every deque exists, they steal from each other.
+    threads.reserve(threadCount);
+    for (std::size_t idx = 0; idx < threadCount; ++idx) {
+        threads.emplace_back([this, idx]() { run(idx); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{sleepMutex};
+        isStopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+void ThreadPool::submit(Task task) {
+    pending.fetch_add(1);
+
+    // Count before pushing so the counter never dips below the number of
+    // tasks actually sitting in deques. Done under the sleep mutex so a
+    // worker about to sleep can't miss it.
+    {
+        std::lock_guard lock{sleepMutex};
+        queued.fetch_add(1);
+    }
+
+    Worker& worker{*workers[nextWorker.fetch_add(1) % workers.size()]};
+    {
+        std::lock_guard lock{worker.mutex};
+        worker.tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock{sleepMutex};
+    allDone.wait(lock, [this]() { return pending.load() == 0; });
+}
+
+std::size_t ThreadPool::getThreadCount() const { return threads.size(); }
+
+// -----------------------------------------------------------------------------
+// Workers
+// -----------------------------------------------------------------------------
+
+void ThreadPool::run(std::size_t index) {
+#if PONG_PROFILE
+    Profiler::setThreadName("Worker " + std::to_string(index));
+#endif
+    Task task;
+    while (true) {
+        if (popOwn(index, task) || steal(index, task)) {
+            queued.fetch_sub(1);
+            task();
+            task = nullptr;
+
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard lock{sleepMutex};
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock{sleepMutex};
+        workAvailable.wait(lock, [this]() { return isStopping || queued.load() > 0; });
+        if (isStopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::popOwn(std::size_t index, Task& task) {
+    Worker& worker{*workers[index]};
+    std::lock_guard lock{worker.mutex};
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(std::size_t thief, Task& task) {
+    for (std::size_t offset = 1; offset < workers.size(); ++offset) {
+        Worker& victim{*workers[(thief + offset) % workers.size()]};
+        std::lock_guard lock{victim.mutex};
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size, work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Submitted tasks are dealt round-robin
+ * across the deques; a worker pops from the back of its own deque (most
+ * recently submitted, still warm in cache) and, once that runs dry, steals
+ * from the front of the others'. Idle workers sleep until more work arrives.
+ *
+ * Tasks must not throw.
+ *
+ * TODO: Tests
+ */
+class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    /**
+     * Start `threadCount` workers. Zero means one per hardware thread.
+     */
+    ThreadPool(std::size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool(ThreadPool&&)                 = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+
+    /**
+     * Queue a task for execution on some worker.
+     */
+    void submit(Task task);
+
+    /**
+     * Block until every submitted task has finished.
+     */
+    void wait();
+
+    std::size_t getThreadCount() const;
+
+  private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(std::size_t index);
+    bool popOwn(std::size_t index, Task& task);
+    bool steal(std::size_t thief, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    /** Round-robin cursor for `submit`. */
+    std::atomic<std::size_t> nextWorker{0};
+
+    /** Tasks submitted but not yet finished. */
+    std::atomic<std::size_t> pending{0};
+
+    /** Tasks submitted but not yet started (wake-up predicate). */
+    std::atomic<std::size_t> queued{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    bool isStopping{false};
+};
@@ -23,3 +23,28 @@ Vector2 Vector2::operator*(const Vector2& rhs) const {
 Vector2 Vector2::operator/(const Vector2& rhs) const {
     return Vector2{x / rhs.x, y / rhs.y};
 }
+
+// -----------------------------------------------------------------------------
+// Fixed-Point
+// -----------------------------------------------------------------------------
+
+FixedVector2::FixedVector2() : x{}, y{} {}
+
+FixedVector2::FixedVector2(Fixed x, Fixed y) : x{x}, y{y} {}
+
+FixedVector2::FixedVector2(const Vector2& whole)
+    : x{Fixed::fromInt(whole.x)}, y{Fixed::fromInt(whole.y)} {}
+
+Vector2 FixedVector2::toVector2() const { return Vector2{x.toInt(), y.toInt()}; }
+
+FixedVector2 FixedVector2::operator+(const FixedVector2& rhs) const {
+    return FixedVector2{x + rhs.x, y + rhs.y};
+}
+
+FixedVector2 FixedVector2::operator-(const FixedVector2& rhs) const {
+    return FixedVector2{x - rhs.x, y - rhs.y};
+}
+
+FixedVector2 FixedVector2::operator*(Fixed scale) const {
+    return FixedVector2{x * scale, y * scale};
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "core/fixed.h"
+
 /**
  * 2-Dimensional Vector.
  * Can be used as a point, velocity, size, etc.
@@ -20,3 +22,27 @@ struct Vector2 {
     Vector2 operator*(const Vector2& rhs) const;
     Vector2 operator/(const Vector2& rhs) const;
 };
+
+/**
+ * 2-Dimensional Vector of 16.16 fixed-point components.
+ * Used for sub-pixel simulation state (see `Fixed`).
+ *
+ * TODO: Tests
+ */
+struct FixedVector2 {
+    Fixed x;
+    Fixed y;
+
+    FixedVector2();
+    FixedVector2(Fixed x, Fixed y);
+    explicit FixedVector2(const Vector2& whole);
+
+    /**
+     * Round to whole pixels.
+     */
+    Vector2 toVector2() const;
+
+    FixedVector2 operator+(const FixedVector2& rhs) const;
+    FixedVector2 operator-(const FixedVector2& rhs) const;
+    FixedVector2 operator*(Fixed scale) const;
+};
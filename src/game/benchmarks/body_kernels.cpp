@@ -0,0 +1,94 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "core/benchmarks/benchmark.h"
+#include "game/body_kernels.h"
+#include "game/body_store.h"
+
+/**
+ * `BodyKernels` at each instruction set level, against the `Rect` path.
+ *
+ * Overlap: N bodies against one paddle, either through
+ * `Rect::minkowskiDifference()` per body (as entities collide) or through
+ * the overlap kernel. Integrate: one position/velocity array pair.
+ */
+
+static const Rect field{0, 0, 256, 256};
+static const Rect paddle{16, 96, 8, 64};
+static const float delta{1.0f / 60};
+
+static BodyStore makeBodies(std::size_t count) {
+    BodyStore bodies;
+    bodies.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        // Scatter over the field so that some, but not most, overlap.
+        bodies.add(static_cast<float>(idx * 7 % field.w),
+                   static_cast<float>(idx * 13 % field.h), 8, 8,
+                   static_cast<float>(idx % 300) - 150, 200);
+    }
+    return bodies;
+}
+
+static void benchmarkRects(std::size_t count) {
+    const BodyStore bodies{makeBodies(count)};
+    std::vector<Rect> rects;
+    rects.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        rects.push_back(bodies.getInterpolatedRect(idx, 1));
+    }
+    std::vector<uint8_t> hits(count);
+
+    runBenchmark("overlap/rect/" + std::to_string(count), [&]() {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            hits[idx] = paddle.minkowskiDifference(rects[idx]).hasPoint(0, 0);
+        }
+        doNotOptimize(hits.data());
+    });
+}
+
+static void benchmarkKernels(BodyKernels::Level level, std::size_t count) {
+    const BodyKernels& kernels{BodyKernels::get(level)};
+    if (kernels.level != level) {
+        std::printf("%-48s %s\n", BodyKernels::getLevelName(level), "(unsupported)");
+        return;
+    }
+    const std::string suffix{std::string{BodyKernels::getLevelName(level)} + "/" +
+                             std::to_string(count)};
+
+    BodyStore bodies{makeBodies(count)};
+    std::vector<uint8_t> hits(count);
+
+    // Bodies sit on whole pixels, so the kernel must agree with `Rect` exactly.
+    kernels.overlap(bodies.x.data(), bodies.y.data(), bodies.w.data(),
+                    bodies.h.data(), count, paddle, hits.data());
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        const Rect rect{bodies.getInterpolatedRect(idx, 1)};
+        if (hits[idx] != paddle.minkowskiDifference(rect).hasPoint(0, 0)) {
+            std::printf("overlap/%s: mismatch at body %zu\n", suffix.c_str(), idx);
+            std::exit(1);
+        }
+    }
+
+    runBenchmark("overlap/" + suffix, [&]() {
+        kernels.overlap(bodies.x.data(), bodies.y.data(), bodies.w.data(),
+                        bodies.h.data(), count, paddle, hits.data());
+        doNotOptimize(hits.data());
+    });
+
+    runBenchmark("integrate/" + suffix, [&]() {
+        kernels.integrate(bodies.x.data(), bodies.vx.data(), count, delta);
+        doNotOptimize(bodies.x.data());
+    });
+}
+
+int main(int argc, char** argv) {
+    for (std::size_t count : {1000, 10000, 100000}) {
+        benchmarkRects(count);
+        for (auto level : {BodyKernels::Level::scalar, BodyKernels::Level::sse2,
+                           BodyKernels::Level::avx2}) {
+            benchmarkKernels(level, count);
+        }
+    }
+    return finishBenchmarks(argc, argv);
+}
@@ -0,0 +1,70 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/benchmarks/benchmark.h"
+#include "game/body_store.h"
+#include "game/entities/ball.h"
+
+/**
+ * Structure-of-arrays `BodyStore` versus one virtual `Entity` per body.
+ *
+ * Both sides do the same per-tick work for N balls: integrate position, then
+ * bounce off the top and bottom of the field.
+ */
+
+static const Rect field{0, 0, 256, 256};
+static const float delta{1.0f / 60};
+
+/**
+ * Heap-allocated `Ball`s behind `Entity` pointers, updated through virtual
+ * dispatch, with wall bounces through the accessor API (as `Match` does).
+ */
+static void benchmarkEntities(std::size_t count) {
+    std::vector<std::unique_ptr<Entity>> entities;
+    entities.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        auto ball{std::make_unique<Ball>()};
+        ball->setPosition(field.w / 2, field.h / 2);
+        ball->setVelocity(static_cast<int>(idx % 300) - 150, 200);
+        entities.push_back(std::move(ball));
+    }
+
+    runBenchmark("entities/" + std::to_string(count), [&]() {
+        for (auto& entity : entities) {
+            entity->update(delta);
+        }
+        for (auto& entity : entities) {
+            Vector2 v{entity->getVelocity()};
+            if (entity->getTopEdgePosition() < field.y) {
+                entity->setVelocity(v.x, std::abs(v.y));
+            } else if (entity->getBottomEdgePosition() > field.y + field.h) {
+                entity->setVelocity(v.x, -std::abs(v.y));
+            }
+        }
+        doNotOptimize(entities.front()->getRect());
+    });
+}
+
+static void benchmarkBodyStore(std::size_t count) {
+    BodyStore bodies;
+    bodies.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        bodies.add(field.w / 2.0f, field.h / 2.0f, 8, 8,
+                   static_cast<float>(idx % 300) - 150, 200);
+    }
+
+    runBenchmark("body_store/" + std::to_string(count), [&]() {
+        bodies.integrate(delta);
+        bodies.bounceWithin(field);
+        doNotOptimize(bodies.y.front());
+    });
+}
+
+int main(int argc, char** argv) {
+    for (std::size_t count : {1000, 10000, 100000}) {
+        benchmarkEntities(count);
+        benchmarkBodyStore(count);
+    }
+    return finishBenchmarks(argc, argv);
+}
@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "core/benchmarks/benchmark.h"
+#include "game/body_store.h"
+#include "game/collision_world.h"
+
+/**
+ * `CollisionWorld` grid broad phase versus comparing every pair.
+ *
+ * N small bodies scattered over the field; each iteration finds every
+ * overlapping pair (the grid side also rebuilds the grid, as `Match` does
+ * every tick). The all-pairs side is skipped where it would take too long.
+ */
+
+static const Rect field{0, 0, 1024, 1024};
+static const float bodySize{4};
+static const std::size_t maxAllPairsCount{10000};
+
+static BodyStore makeBodies(std::size_t count) {
+    // Fixed-seed xorshift, so every run sees the same scatter.
+    uint32_t state{2463534242u};
+    const auto next = [&state](int range) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<float>(state % static_cast<uint32_t>(range));
+    };
+
+    BodyStore bodies;
+    bodies.reserve(count);
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        const float x{next(field.w)};
+        bodies.add(x, next(field.h), bodySize, bodySize, 0, 0);
+    }
+    return bodies;
+}
+
+static void findAllPairs(const BodyStore& bodies,
+                         std::vector<CollisionWorld::Pair>& pairs) {
+    const std::size_t count{bodies.size()};
+    for (std::size_t a = 0; a < count; ++a) {
+        for (std::size_t b = a + 1; b < count; ++b) {
+            if (bodies.x[a] < bodies.x[b] + bodies.w[b] &&
+                bodies.x[b] < bodies.x[a] + bodies.w[a] &&
+                bodies.y[a] < bodies.y[b] + bodies.h[b] &&
+                bodies.y[b] < bodies.y[a] + bodies.h[a]) {
+                pairs.push_back({static_cast<CollisionWorld::Id>(a),
+                                 static_cast<CollisionWorld::Id>(b)});
+            }
+        }
+    }
+}
+
+static void findGridPairs(CollisionWorld& world, const BodyStore& bodies,
+                          std::vector<CollisionWorld::Pair>& pairs) {
+    world.clear();
+    for (std::size_t idx = 0; idx < bodies.size(); ++idx) {
+        world.add(bodies.x[idx], bodies.y[idx], bodies.w[idx], bodies.h[idx]);
+    }
+    world.build();
+    world.findPairs(pairs);
+}
+
+static void benchmark(std::size_t count) {
+    const BodyStore bodies{makeBodies(count)};
+    CollisionWorld world{{.field = field, .cellSize = 4 * static_cast<int>(bodySize)}};
+    std::vector<CollisionWorld::Pair> pairs;
+
+    findGridPairs(world, bodies, pairs);
+    const std::size_t gridPairs{pairs.size()};
+
+    if (count <= maxAllPairsCount) {
+        // Both must find the same number of pairs (each pair exactly once).
+        pairs.clear();
+        findAllPairs(bodies, pairs);
+        if (pairs.size() != gridPairs) {
+            std::printf("pairs/%zu: grid found %zu, all-pairs found %zu\n", count,
+                        gridPairs, pairs.size());
+            std::exit(1);
+        }
+
+        runBenchmark("pairs/all/" + std::to_string(count), [&]() {
+            pairs.clear();
+            findAllPairs(bodies, pairs);
+            doNotOptimize(pairs.data());
+        });
+    }
+
+    runBenchmark("pairs/grid/" + std::to_string(count), [&]() {
+        pairs.clear();
+        findGridPairs(world, bodies, pairs);
+        doNotOptimize(pairs.data());
+    });
+
+    std::vector<CollisionWorld::Id> hits;
+    const Rect paddle{field.w / 6, field.h / 2 - 32, 8, 64};
+    runBenchmark("query/grid/" + std::to_string(count), [&]() {
+        hits.clear();
+        world.query(paddle, hits);
+        doNotOptimize(hits.data());
+    });
+}
+
+int main(int argc, char** argv) {
+    for (std::size_t count : {100, 1000, 10000, 100000}) {
+        benchmark(count);
+    }
+    return finishBenchmarks(argc, argv);
+}
@@ -0,0 +1,35 @@
+#include <SDL.h>
+
+#include "core/benchmarks/benchmark.h"
+#include "core/glyph_atlas.h"
+#include "game/entities/countdown.h"
+
+/**
+ * `Countdown::update`, one tick per iteration, including the wrap-around
+ * and callback once per countdown.
+ *
+ * The countdown never draws here, but needs an atlas to exist; a blank one
+ * is made with SDL's software renderer, so no window or GPU is needed.
+ */
+
+int main(int argc, char** argv) {
+    SDL_Surface* surface{
+        SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_RGBA8888)};
+    SDL_Renderer* renderer{SDL_CreateSoftwareRenderer(surface)};
+    uint64_t timeouts{0};
+    {
+        const GlyphAtlas atlas{Texture{SDL_CreateTextureFromSurface(renderer, surface)},
+                               {},
+                               16};
+        Countdown countdown{3,          600, atlas, {"GO!", "1", "2", "3"},
+                            [&timeouts]() { ++timeouts; },
+                            Vector2{128, 128}};
+
+        runBenchmark("countdown/update", [&]() { countdown.update(1.0f / 60); });
+    }
+    doNotOptimize(timeouts);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    return finishBenchmarks(argc, argv);
+}
@@ -0,0 +1,31 @@
+#include "core/benchmarks/benchmark.h"
+#include "game/entities/ball.h"
+
+/**
+ * `Entity` motion, one ball per iteration: the fixed-point `move` alone,
+ * and with the interpolation snapshot that precedes it every tick.
+ */
+
+int main(int argc, char** argv) {
+    const float delta{1.0f / 60};
+
+    Ball ball;
+    ball.setPosition(128, 128);
+    ball.setVelocity(240, -180);
+
+    runBenchmark("entity/move", [&]() {
+        ball.move(delta);
+        doNotOptimize(ball.getFixedTopLeft());
+    });
+
+    runBenchmark("entity/snapshot+move", [&]() {
+        ball.snapshot();
+        ball.move(delta);
+        doNotOptimize(ball.getFixedTopLeft());
+    });
+
+    runBenchmark("entity/getInterpolatedRect",
+                 [&]() { doNotOptimize(ball.getInterpolatedRect(0.5f)); });
+
+    return finishBenchmarks(argc, argv);
+}
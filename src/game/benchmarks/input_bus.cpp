@@ -0,0 +1,51 @@
+#include <string>
+#include <vector>
+
+#include "core/benchmarks/benchmark.h"
+#include "game/input_bus.h"
+
+/**
+ * `InputBus` key-down dispatch, one event per iteration, to a growing number
+ * of subscribers. Also the cost of an unmapped key, which every stray key
+ * press pays, and of subscribing and unsubscribing once.
+ */
+
+int main(int argc, char** argv) {
+    InputBus& input{InputBus::get()};
+    InputBus::Config config;
+    config.setKeyboardKeyDownAction(SDL_SCANCODE_P, InputBus::Action::pause);
+    input.initialize(config);
+
+    SDL_KeyboardEvent mapped{};
+    mapped.keysym.scancode = SDL_SCANCODE_P;
+    SDL_KeyboardEvent unmapped{};
+    unmapped.keysym.scancode = SDL_SCANCODE_F;
+
+    uint64_t received{0};
+    std::vector<InputBus::Subscription> subscriptions;
+
+    runBenchmark("input_bus/dispatch/unmapped",
+                 [&]() { input.handleKeyDownEvent(unmapped); });
+
+    for (std::size_t count : {1, 4, 16}) {
+        while (subscriptions.size() < count) {
+            subscriptions.push_back(input.onActionPressed(
+                [&received](InputBus::Action action) {
+                    received += static_cast<uint64_t>(action);
+                }));
+        }
+        runBenchmark("input_bus/dispatch/" + std::to_string(count),
+                     [&]() { input.handleKeyDownEvent(mapped); });
+    }
+    doNotOptimize(received);
+
+    runBenchmark("input_bus/subscribe", [&]() {
+        InputBus::Subscription subscription{input.onActionPressed(
+            [&received](InputBus::Action action) {
+                received += action != InputBus::Action::none;
+            })};
+    });
+
+    subscriptions.clear();
+    return finishBenchmarks(argc, argv);
+}
@@ -0,0 +1,68 @@
+#include <string>
+
+#include "core/benchmarks/benchmark.h"
+#include "game/match.h"
+#include "game/match_farm.h"
+
+/**
+ * Whole-simulation costs, computer against computer on the real game's
+ * field and tick rate:
+ *
+ * - One `Match::step` (steering, motion, sweep, collisions, scoring), with
+ *   and without chaos balls. Points are served and finished matches reset
+ *   as needed, outside the timed step's own work.
+ * - One whole match, start to finish, on this thread.
+ * - One whole match's share of a batch on a `MatchFarm` using every
+ *   hardware thread, i.e. headless throughput.
+ */
+
+static const float delta{1.0f / 60};
+
+static Match::Config makeConfig(uint32_t chaosBalls) {
+    return Match::Config{
+        .field      = Rect{0, 0, 256, 256},
+        .leftPilot  = {.kind = Pilot::Kind::computer},
+        .rightPilot = {.kind = Pilot::Kind::computer},
+        .chaosBalls = chaosBalls,
+    };
+}
+
+static void benchmarkStep(uint32_t chaosBalls) {
+    Match match{makeConfig(chaosBalls)};
+    match.reset();
+    match.serve();
+    runBenchmark("match/step/chaos/" + std::to_string(chaosBalls), [&]() {
+        switch (match.step(delta)) {
+        case Match::Phase::over:
+            match.reset();
+            match.serve();
+            break;
+        case Match::Phase::point:
+            match.serve();
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    for (uint32_t chaosBalls : {0u, 100u, 1000u}) {
+        benchmarkStep(chaosBalls);
+    }
+
+    Match match{makeConfig(0)};
+    runBenchmark("match/play", [&]() { match.play(delta); });
+
+    // Small tasks, so that every worker gets a share of the batch.
+    static const uint64_t batch{256};
+    MatchFarm farm{{.threads = 0, .matchesPerTask = 4}};
+    const Match::Config config{makeConfig(0)};
+    const BenchmarkResult farmed{runBenchmark(
+        "match/farm/batch/" + std::to_string(batch),
+        [&]() { doNotOptimize(farm.play(config, batch, delta).matches); }, 1.0)};
+    std::printf("%-48s %29.1f matches/s\n", "match/farm/throughput",
+                batch * 1e9 / farmed.nanoseconds);
+
+    return finishBenchmarks(argc, argv);
+}
@@ -0,0 +1,341 @@
+#include <bit>
+#include <cmath>
+
+#include <SDL_cpuinfo.h>
+
+#include "body_kernels.h"
+
+// SSE2 is part of x86-64 itself, so it needs no target attribute; AVX2 is
+// compiled per function with GCC/Clang's `target`. Anything else (32-bit x86,
+// other compilers) gets the scalar kernels only.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BODY_KERNELS_X86
+#endif
+
+// -----------------------------------------------------------------------------
+// Shared Helpers
+// -----------------------------------------------------------------------------
+
+/** `Rect` edges as floats, for comparing against body components. */
+struct RectEdges {
+    RectEdges(const Rect& rect)
+        : left{static_cast<float>(rect.x)}, top{static_cast<float>(rect.y)},
+          right{static_cast<float>(rect.x + rect.w)},
+          bottom{static_cast<float>(rect.y + rect.h)},
+          centerX{rect.x + rect.w / 2.0f} {}
+    float left;
+    float top;
+    float right;
+    float bottom;
+    float centerX;
+};
+
+// -----------------------------------------------------------------------------
+// Scalar (also handles the tails of the vector kernels)
+// -----------------------------------------------------------------------------
+
+static void integrateScalar(float* position, const float* velocity, std::size_t count,
+                            float delta) {
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        position[idx] += velocity[idx] * delta;
+    }
+}
+
+static void overlapScalar(const float* x, const float* y, const float* w,
+                          const float* h, std::size_t count, const Rect& rect,
+                          uint8_t* hits) {
+    const RectEdges box{rect};
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        hits[idx] = x[idx] < box.right && box.left < x[idx] + w[idx] &&
+                    y[idx] < box.bottom && box.top < y[idx] + h[idx];
+    }
+}
+
+static void bounceWithinScalar(const float* y, const float* h, float* vy,
+                               std::size_t count, float top, float bottom) {
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        const float speed{std::abs(vy[idx])};
+        const bool aboveTop{y[idx] < top};
+        const bool belowBottom{y[idx] + h[idx] > bottom};
+        vy[idx] = aboveTop ? speed : (belowBottom ? -speed : vy[idx]);
+    }
+}
+
+static std::size_t bounceOffScalar(const float* x, const float* y, const float* w,
+                                   const float* h, float* vx, std::size_t count,
+                                   const Rect& rect) {
+    const RectEdges box{rect};
+    std::size_t bounces{0};
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        const bool overlaps{x[idx] < box.right && box.left < x[idx] + w[idx] &&
+                            y[idx] < box.bottom && box.top < y[idx] + h[idx]};
+        const float speed{std::abs(vx[idx])};
+        const float outward{x[idx] + w[idx] / 2 < box.centerX ? -speed : speed};
+        bounces += overlaps && outward != vx[idx];
+        vx[idx] = overlaps ? outward : vx[idx];
+    }
+    return bounces;
+}
+
+#ifdef BODY_KERNELS_X86
+
+// -----------------------------------------------------------------------------
+// SSE2 (4 lanes)
+// -----------------------------------------------------------------------------
+
+/** Select `a` where `mask` is set, else `b` (SSE2 has no blendv). */
+static inline __m128 select128(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 overlapMask128(__m128 x, __m128 y, __m128 w, __m128 h,
+                                    const RectEdges& box) {
+    __m128 mask{_mm_cmplt_ps(x, _mm_set1_ps(box.right))};
+    mask = _mm_and_ps(mask, _mm_cmplt_ps(_mm_set1_ps(box.left), _mm_add_ps(x, w)));
+    mask = _mm_and_ps(mask, _mm_cmplt_ps(y, _mm_set1_ps(box.bottom)));
+    mask = _mm_and_ps(mask, _mm_cmplt_ps(_mm_set1_ps(box.top), _mm_add_ps(y, h)));
+    return mask;
+}
+
+static void integrateSse2(float* position, const float* velocity, std::size_t count,
+                          float delta) {
+    const __m128 d{_mm_set1_ps(delta)};
+    std::size_t idx{0};
+    for (; idx + 4 <= count; idx += 4) {
+        __m128 p{_mm_loadu_ps(position + idx)};
+        __m128 v{_mm_loadu_ps(velocity + idx)};
+        _mm_storeu_ps(position + idx, _mm_add_ps(p, _mm_mul_ps(v, d)));
+    }
+    integrateScalar(position + idx, velocity + idx, count - idx, delta);
+}
+
+/** Narrow sixteen all-ones/all-zeros lane masks to sixteen 1/0 bytes. */
+static inline __m128i packMasks(__m128 a, __m128 b, __m128 c, __m128 d) {
+    const __m128i low{_mm_packs_epi32(_mm_castps_si128(a), _mm_castps_si128(b))};
+    const __m128i high{_mm_packs_epi32(_mm_castps_si128(c), _mm_castps_si128(d))};
+    return _mm_and_si128(_mm_packs_epi16(low, high), _mm_set1_epi8(1));
+}
+
+static void overlapSse2(const float* x, const float* y, const float* w,
+                        const float* h, std::size_t count, const Rect& rect,
+                        uint8_t* hits) {
+    const RectEdges box{rect};
+    const auto maskAt = [&](std::size_t at) {
+        return overlapMask128(_mm_loadu_ps(x + at), _mm_loadu_ps(y + at),
+                              _mm_loadu_ps(w + at), _mm_loadu_ps(h + at), box);
+    };
+    std::size_t idx{0};
+    for (; idx + 16 <= count; idx += 16) {
+        const __m128i bytes{
+            packMasks(maskAt(idx), maskAt(idx + 4), maskAt(idx + 8), maskAt(idx + 12))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hits + idx), bytes);
+    }
+    overlapScalar(x + idx, y + idx, w + idx, h + idx, count - idx, rect, hits + idx);
+}
+
+static void bounceWithinSse2(const float* y, const float* h, float* vy,
+                             std::size_t count, float top, float bottom) {
+    const __m128 sign{_mm_set1_ps(-0.0f)};
+    const __m128 topEdge{_mm_set1_ps(top)};
+    const __m128 bottomEdge{_mm_set1_ps(bottom)};
+    std::size_t idx{0};
+    for (; idx + 4 <= count; idx += 4) {
+        const __m128 py{_mm_loadu_ps(y + idx)};
+        const __m128 v{_mm_loadu_ps(vy + idx)};
+        const __m128 speed{_mm_andnot_ps(sign, v)};
+        const __m128 above{_mm_cmplt_ps(py, topEdge)};
+        const __m128 bottoms{_mm_add_ps(py, _mm_loadu_ps(h + idx))};
+        const __m128 below{_mm_cmpgt_ps(bottoms, bottomEdge)};
+        __m128 result{select128(below, _mm_xor_ps(speed, sign), v)};
+        result = select128(above, speed, result);
+        _mm_storeu_ps(vy + idx, result);
+    }
+    bounceWithinScalar(y + idx, h + idx, vy + idx, count - idx, top, bottom);
+}
+
+static std::size_t bounceOffSse2(const float* x, const float* y, const float* w,
+                                 const float* h, float* vx, std::size_t count,
+                                 const Rect& rect) {
+    const RectEdges box{rect};
+    const __m128 sign{_mm_set1_ps(-0.0f)};
+    const __m128 half{_mm_set1_ps(0.5f)};
+    const __m128 center{_mm_set1_ps(box.centerX)};
+    std::size_t bounces{0};
+    std::size_t idx{0};
+    for (; idx + 4 <= count; idx += 4) {
+        const __m128 px{_mm_loadu_ps(x + idx)};
+        const __m128 pw{_mm_loadu_ps(w + idx)};
+        const __m128 v{_mm_loadu_ps(vx + idx)};
+        const __m128 overlaps{overlapMask128(px, _mm_loadu_ps(y + idx), pw,
+                                             _mm_loadu_ps(h + idx), box)};
+        const __m128 speed{_mm_andnot_ps(sign, v)};
+        const __m128 isLeftOfCenter{
+            _mm_cmplt_ps(_mm_add_ps(px, _mm_mul_ps(pw, half)), center)};
+        const __m128 outward{select128(isLeftOfCenter, _mm_xor_ps(speed, sign), speed)};
+        const __m128 changed{_mm_and_ps(overlaps, _mm_cmpneq_ps(outward, v))};
+        bounces += std::popcount(static_cast<unsigned>(_mm_movemask_ps(changed)));
+        _mm_storeu_ps(vx + idx, select128(overlaps, outward, v));
+    }
+    return bounces + bounceOffScalar(x + idx, y + idx, w + idx, h + idx, vx + idx,
+                                     count - idx, rect);
+}
+
+// -----------------------------------------------------------------------------
+// AVX2 (8 lanes, two vectors per iteration)
+// -----------------------------------------------------------------------------
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static inline __m256 overlapMask256(__m256 x, __m256 y, __m256 w, __m256 h,
+                                         const RectEdges& box) {
+    __m256 mask{_mm256_cmp_ps(x, _mm256_set1_ps(box.right), _CMP_LT_OQ)};
+    mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_set1_ps(box.left),
+                                             _mm256_add_ps(x, w), _CMP_LT_OQ));
+    mask = _mm256_and_ps(mask,
+                         _mm256_cmp_ps(y, _mm256_set1_ps(box.bottom), _CMP_LT_OQ));
+    mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_set1_ps(box.top),
+                                             _mm256_add_ps(y, h), _CMP_LT_OQ));
+    return mask;
+}
+
+AVX2 static void integrateAvx2(float* position, const float* velocity,
+                               std::size_t count, float delta) {
+    const __m256 d{_mm256_set1_ps(delta)};
+    std::size_t idx{0};
+    for (; idx + 16 <= count; idx += 16) {
+        __m256 p0{_mm256_loadu_ps(position + idx)};
+        __m256 p1{_mm256_loadu_ps(position + idx + 8)};
+        __m256 v0{_mm256_loadu_ps(velocity + idx)};
+        __m256 v1{_mm256_loadu_ps(velocity + idx + 8)};
+        _mm256_storeu_ps(position + idx, _mm256_add_ps(p0, _mm256_mul_ps(v0, d)));
+        _mm256_storeu_ps(position + idx + 8, _mm256_add_ps(p1, _mm256_mul_ps(v1, d)));
+    }
+    integrateSse2(position + idx, velocity + idx, count - idx, delta);
+}
+
+AVX2 static void overlapAvx2(const float* x, const float* y, const float* w,
+                             const float* h, std::size_t count, const Rect& rect,
+                             uint8_t* hits) {
+    const RectEdges box{rect};
+    const auto maskAt = [&](std::size_t at) AVX2 {
+        return overlapMask256(_mm256_loadu_ps(x + at), _mm256_loadu_ps(y + at),
+                              _mm256_loadu_ps(w + at), _mm256_loadu_ps(h + at), box);
+    };
+    std::size_t idx{0};
+    for (; idx + 16 <= count; idx += 16) {
+        const __m256 low{maskAt(idx)};
+        const __m256 high{maskAt(idx + 8)};
+        const __m128i bytes{packMasks(
+            _mm256_castps256_ps128(low), _mm256_extractf128_ps(low, 1),
+            _mm256_castps256_ps128(high), _mm256_extractf128_ps(high, 1))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hits + idx), bytes);
+    }
+    overlapSse2(x + idx, y + idx, w + idx, h + idx, count - idx, rect, hits + idx);
+}
+
+AVX2 static void bounceWithinAvx2(const float* y, const float* h, float* vy,
+                                  std::size_t count, float top, float bottom) {
+    const __m256 sign{_mm256_set1_ps(-0.0f)};
+    const __m256 topEdge{_mm256_set1_ps(top)};
+    const __m256 bottomEdge{_mm256_set1_ps(bottom)};
+    std::size_t idx{0};
+    for (; idx + 8 <= count; idx += 8) {
+        const __m256 py{_mm256_loadu_ps(y + idx)};
+        const __m256 v{_mm256_loadu_ps(vy + idx)};
+        const __m256 speed{_mm256_andnot_ps(sign, v)};
+        const __m256 above{_mm256_cmp_ps(py, topEdge, _CMP_LT_OQ)};
+        const __m256 below{_mm256_cmp_ps(_mm256_add_ps(py, _mm256_loadu_ps(h + idx)),
+                                         bottomEdge, _CMP_GT_OQ)};
+        __m256 result{_mm256_blendv_ps(v, _mm256_xor_ps(speed, sign), below)};
+        result = _mm256_blendv_ps(result, speed, above);
+        _mm256_storeu_ps(vy + idx, result);
+    }
+    bounceWithinSse2(y + idx, h + idx, vy + idx, count - idx, top, bottom);
+}
+
+AVX2 static std::size_t bounceOffAvx2(const float* x, const float* y, const float* w,
+                                      const float* h, float* vx, std::size_t count,
+                                      const Rect& rect) {
+    const RectEdges box{rect};
+    const __m256 sign{_mm256_set1_ps(-0.0f)};
+    const __m256 half{_mm256_set1_ps(0.5f)};
+    const __m256 center{_mm256_set1_ps(box.centerX)};
+    std::size_t bounces{0};
+    std::size_t idx{0};
+    for (; idx + 8 <= count; idx += 8) {
+        const __m256 px{_mm256_loadu_ps(x + idx)};
+        const __m256 pw{_mm256_loadu_ps(w + idx)};
+        const __m256 v{_mm256_loadu_ps(vx + idx)};
+        const __m256 overlaps{overlapMask256(px, _mm256_loadu_ps(y + idx), pw,
+                                             _mm256_loadu_ps(h + idx), box)};
+        const __m256 speed{_mm256_andnot_ps(sign, v)};
+        const __m256 isLeftOfCenter{_mm256_cmp_ps(
+            _mm256_add_ps(px, _mm256_mul_ps(pw, half)), center, _CMP_LT_OQ)};
+        const __m256 outward{
+            _mm256_blendv_ps(speed, _mm256_xor_ps(speed, sign), isLeftOfCenter)};
+        const __m256 changed{
+            _mm256_and_ps(overlaps, _mm256_cmp_ps(outward, v, _CMP_NEQ_UQ))};
+        bounces += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(changed)));
+        _mm256_storeu_ps(vx + idx, _mm256_blendv_ps(v, outward, overlaps));
+    }
+    return bounces + bounceOffSse2(x + idx, y + idx, w + idx, h + idx, vx + idx,
+                                   count - idx, rect);
+}
+
+#undef AVX2
+
+#endif // BODY_KERNELS_X86
+
+// -----------------------------------------------------------------------------
+// Kernel Tables & Runtime Selection
+// -----------------------------------------------------------------------------
+
+static const BodyKernels scalarKernels{
+    integrateScalar, overlapScalar, bounceWithinScalar, bounceOffScalar,
+    BodyKernels::Level::scalar,
+};
+
+#ifdef BODY_KERNELS_X86
+static const BodyKernels sse2Kernels{
+    integrateSse2, overlapSse2, bounceWithinSse2, bounceOffSse2,
+    BodyKernels::Level::sse2,
+};
+
+static const BodyKernels avx2Kernels{
+    integrateAvx2, overlapAvx2, bounceWithinAvx2, bounceOffAvx2,
+    BodyKernels::Level::avx2,
+};
+#endif
+
+const BodyKernels& BodyKernels::get(Level level) {
+#ifdef BODY_KERNELS_X86
+    static const bool hasAvx2{SDL_HasAVX2() == SDL_TRUE};
+    static const bool hasSse2{SDL_HasSSE2() == SDL_TRUE};
+    if (level >= Level::avx2 && hasAvx2) {
+        return avx2Kernels;
+    }
+    if (level >= Level::sse2 && hasSse2) {
+        return sse2Kernels;
+    }
+#else
+    (void)level;
+#endif
+    return scalarKernels;
+}
+
+const BodyKernels& BodyKernels::get() {
+    static const BodyKernels& best{get(Level::avx2)};
+    return best;
+}
+
+const char* BodyKernels::getLevelName(Level level) {
+    switch (level) {
+    case Level::sse2:
+        return "sse2";
+    case Level::avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/rect.h"
+
+/**
+ * Bulk kernels over `BodyStore` component arrays.
+ *
+ * Each kernel exists as a scalar fallback plus SSE2 (4 bodies per
+ * instruction) and AVX2 (8 bodies per instruction, 16 per loop iteration)
+ * variants on x86-64 (GCC and Clang builds). The widest variant the CPU
+ * supports is chosen at runtime, once, by `BodyKernels::get()`.
+ *
+ * All arrays are indexed in lockstep and hold `count` elements; none need be
+ * aligned. Overlap tests match `(box - body).hasPoint(0, 0)` (the Minkowski
+ * difference test used for `Rect`s), i.e. touching edges do not overlap.
+ *
+ * TODO: Tests
+ */
+struct BodyKernels {
+    enum class Level {
+        scalar,
+        sse2,
+        avx2,
+    };
+
+    /** position[i] += velocity[i] * delta */
+    void (*integrate)(float* position, const float* velocity, std::size_t count,
+                      float delta);
+
+    /** hits[i] = body i overlaps `box` (1 or 0) */
+    void (*overlap)(const float* x, const float* y, const float* w, const float* h,
+                    std::size_t count, const Rect& box, uint8_t* hits);
+
+    /**
+     * Reflect bodies off the `top` and bottom edges of a field, by making
+     * vy positive above `top` and negative below `bottom`.
+     */
+    void (*bounceWithin)(const float* y, const float* h, float* vy, std::size_t count,
+                         float top, float bottom);
+
+    /**
+     * Point vx of bodies overlapping `paddle` away from the paddle's center
+     * line. Returns how many bodies changed direction.
+     */
+    std::size_t (*bounceOff)(const float* x, const float* y, const float* w,
+                             const float* h, float* vx, std::size_t count,
+                             const Rect& paddle);
+
+    Level level;
+
+    /**
+     * Get the best kernels this CPU supports.
+     */
+    static const BodyKernels& get();
+
+    /**
+     * Get kernels of a specific level, or the best available at or below it.
+     * Mostly for benchmarks and comparisons.
+     */
+    static const BodyKernels& get(Level level);
+
+    static const char* getLevelName(Level level);
+};
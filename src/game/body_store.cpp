@@ -0,0 +1,86 @@
+#include <cmath>
+
+#include "body_kernels.h"
+#include "body_store.h"
+
+// -----------------------------------------------------------------------------
+// Management
+// -----------------------------------------------------------------------------
+
+BodyStore::Index BodyStore::add(float x, float y, float w, float h, float vx,
+                                float vy) {
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->w.push_back(w);
+    this->h.push_back(h);
+    this->vx.push_back(vx);
+    this->vy.push_back(vy);
+    previousX.push_back(x);
+    previousY.push_back(y);
+    return size() - 1;
+}
+
+void BodyStore::remove(Index index) {
+    for (std::vector<float>* component :
+         {&x, &y, &w, &h, &vx, &vy, &previousX, &previousY}) {
+        (*component)[index] = component->back();
+        component->pop_back();
+    }
+}
+
+void BodyStore::clear() {
+    for (std::vector<float>* component :
+         {&x, &y, &w, &h, &vx, &vy, &previousX, &previousY}) {
+        component->clear();
+    }
+}
+
+void BodyStore::reserve(std::size_t count) {
+    for (std::vector<float>* component :
+         {&x, &y, &w, &h, &vx, &vy, &previousX, &previousY}) {
+        component->reserve(count);
+    }
+}
+
+std::size_t BodyStore::size() const { return x.size(); }
+
+// -----------------------------------------------------------------------------
+// Phases
+// -----------------------------------------------------------------------------
+
+void BodyStore::snapshot() {
+    previousX = x;
+    previousY = y;
+}
+
+void BodyStore::integrate(float delta) {
+    const BodyKernels& kernels{BodyKernels::get()};
+    kernels.integrate(x.data(), vx.data(), size(), delta);
+    kernels.integrate(y.data(), vy.data(), size(), delta);
+}
+
+void BodyStore::bounceWithin(const Rect& field) {
+    BodyKernels::get().bounceWithin(y.data(), h.data(), vy.data(), size(),
+                                    static_cast<float>(field.y),
+                                    static_cast<float>(field.y + field.h));
+}
+
+std::size_t BodyStore::bounceOff(const Rect& paddle) {
+    return BodyKernels::get().bounceOff(x.data(), y.data(), w.data(), h.data(),
+                                        vx.data(), size(), paddle);
+}
+
+// -----------------------------------------------------------------------------
+// Access
+// -----------------------------------------------------------------------------
+
+Rect BodyStore::getInterpolatedRect(Index index, float alpha) const {
+    const float ix{previousX[index] + (x[index] - previousX[index]) * alpha};
+    const float iy{previousY[index] + (y[index] - previousY[index]) * alpha};
+    return Rect{
+        static_cast<int>(std::round(ix)),
+        static_cast<int>(std::round(iy)),
+        static_cast<int>(w[index]),
+        static_cast<int>(h[index]),
+    };
+}
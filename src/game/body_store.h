@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/rect.h"
+
+/**
+ * Structure-of-arrays store for large numbers of simple moving boxes.
+ *
+ * Where an `Entity` keeps its geometry and velocity together behind a
+ * virtual interface, a `BodyStore` keeps each component in its own
+ * contiguous array so that phase-wide loops (integrate, bounce, ...) stream
+ * through memory and stay free of indirect calls. Bodies are identified by
+ * index; removal swaps the last body into the hole.
+ *
+ * Positions are top-left corners in floating point, so slow bodies at high
+ * tick rates do not stall on integer rounding.
+ *
+ * TODO: Tests
+ */
+struct BodyStore {
+    using Index = std::size_t;
+
+    // --- Components
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> w;
+    std::vector<float> h;
+    std::vector<float> vx;
+    std::vector<float> vy;
+
+    /** Positions at the start of the tick, for render interpolation. */
+    std::vector<float> previousX;
+    std::vector<float> previousY;
+
+    // --- Management
+    Index add(float x, float y, float w, float h, float vx, float vy);
+    void remove(Index index);
+    void clear();
+    void reserve(std::size_t count);
+    std::size_t size() const;
+
+    // --- Phases
+
+    /**
+     * Record current positions as the previous simulation state.
+     */
+    void snapshot();
+
+    /**
+     * Advance every body by its velocity.
+     */
+    void integrate(float delta);
+
+    /**
+     * Reflect bodies off the top and bottom edges of `field`.
+     */
+    void bounceWithin(const Rect& field);
+
+    /**
+     * Reflect bodies overlapping `paddle` away from its center line.
+     * Returns how many bodies were turned around.
+     */
+    std::size_t bounceOff(const Rect& paddle);
+
+    // --- Access
+
+    /**
+     * Get a body's geometry, blended between the previous (`alpha` of 0)
+     * and current (`alpha` of 1) simulation states.
+     */
+    Rect getInterpolatedRect(Index index, float alpha) const;
+};
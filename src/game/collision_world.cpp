@@ -0,0 +1,165 @@
+#include <algorithm>
+
+#include "collision_world.h"
+
+// -----------------------------------------------------------------------------
+// Static Function Components
+// -----------------------------------------------------------------------------
+
+template <typename A, typename B>
+static bool isOverlapping(const A& a, const B& b) {
+    return a.left < b.right && b.left < a.right && a.top < b.bottom &&
+           b.top < a.bottom;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+
+CollisionWorld::CollisionWorld(const Config& config)
+    : originX{static_cast<float>(config.field.x)},
+      originY{static_cast<float>(config.field.y)},
+      cellSize{std::max(config.cellSize, 1)}, inverseCellSize{1.0f / cellSize},
+      columns{std::max((config.field.w + cellSize - 1) / cellSize, 1)},
+      rows{std::max((config.field.h + cellSize - 1) / cellSize, 1)},
+      cellStart(static_cast<std::size_t>(columns * rows) + 1),
+      cellCursor(static_cast<std::size_t>(columns * rows)) {}
+
+// -----------------------------------------------------------------------------
+// Bodies
+// -----------------------------------------------------------------------------
+
+void CollisionWorld::clear() {
+    bodies.clear();
+    spans.clear();
+    cellEntries.clear();
+}
+
+CollisionWorld::Id CollisionWorld::add(float x, float y, float w, float h) {
+    const Id id{static_cast<Id>(bodies.size())};
+    const Span span{getSpan(x, y, x + w, y + h)};
+    bodies.push_back({
+        x,
+        y,
+        x + w,
+        y + h,
+        static_cast<int16_t>(span.minColumn),
+        static_cast<int16_t>(span.minRow),
+        id,
+    });
+    spans.push_back(span);
+    return id;
+}
+
+void CollisionWorld::build() {
+    // Counting sort: count entries per cell, prefix-sum into offsets, then
+    // scatter. Bodies are visited in Id order, so each cell ends up sorted.
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (const Span& span : spans) {
+        for (int row = span.minRow; row <= span.maxRow; ++row) {
+            for (int column = span.minColumn; column <= span.maxColumn; ++column) {
+                ++cellStart[row * columns + column + 1];
+            }
+        }
+    }
+    for (std::size_t cell = 1; cell < cellStart.size(); ++cell) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+
+    cellEntries.resize(cellStart.back());
+    std::copy(cellStart.begin(), cellStart.end() - 1, cellCursor.begin());
+    for (const Entry& body : bodies) {
+        const Span& span{spans[body.id]};
+        for (int row = span.minRow; row <= span.maxRow; ++row) {
+            for (int column = span.minColumn; column <= span.maxColumn; ++column) {
+                cellEntries[cellCursor[row * columns + column]++] = body;
+            }
+        }
+    }
+}
+
+std::size_t CollisionWorld::size() const { return bodies.size(); }
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+void CollisionWorld::findPairs(std::vector<Pair>& pairs) const {
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const int cell{row * columns + column};
+            const Entry* begin{cellEntries.data() + cellStart[cell]};
+            const Entry* end{cellEntries.data() + cellStart[cell + 1]};
+            for (const Entry* a = begin; a < end; ++a) {
+                for (const Entry* b = a + 1; b < end; ++b) {
+                    if (!isOverlapping(*a, *b)) {
+                        continue;
+                    }
+                    // Bodies spanning several cells meet in each of them;
+                    // only report the pair from the first cell they share.
+                    if (std::max(a->minColumn, b->minColumn) == column &&
+                        std::max(a->minRow, b->minRow) == row) {
+                        pairs.push_back({a->id, b->id});
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CollisionWorld::query(const Rect& area, std::vector<Id>& hits) const {
+    const struct {
+        float left;
+        float top;
+        float right;
+        float bottom;
+    } box{
+        static_cast<float>(area.x),
+        static_cast<float>(area.y),
+        static_cast<float>(area.x + area.w),
+        static_cast<float>(area.y + area.h),
+    };
+    const Span range{getSpan(box.left, box.top, box.right, box.bottom)};
+
+    for (int row = range.minRow; row <= range.maxRow; ++row) {
+        for (int column = range.minColumn; column <= range.maxColumn; ++column) {
+            const int cell{row * columns + column};
+            for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                const Entry& entry{cellEntries[i]};
+                // As with pairs, only report from the first cell in common.
+                if (isOverlapping(entry, box) &&
+                    std::max<int>(entry.minColumn, range.minColumn) == column &&
+                    std::max<int>(entry.minRow, range.minRow) == row) {
+                    hits.push_back(entry.id);
+                }
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Access
+// -----------------------------------------------------------------------------
+
+int CollisionWorld::getColumns() const { return columns; }
+int CollisionWorld::getRows() const { return rows; }
+
+// -----------------------------------------------------------------------------
+// Private Methods
+// -----------------------------------------------------------------------------
+
+CollisionWorld::Span CollisionWorld::getSpan(float left, float top, float right,
+                                             float bottom) const {
+    // Truncating toward zero (rather than flooring) only differs below zero,
+    // which the clamp sends to the first cell either way.
+    const auto toCell = [this](float offset, int cells) {
+        const int cell{static_cast<int>(offset * inverseCellSize)};
+        return std::clamp(cell, 0, cells - 1);
+    };
+    return Span{
+        toCell(left - originX, columns),
+        toCell(top - originY, rows),
+        toCell(right - originX, columns),
+        toCell(bottom - originY, rows),
+    };
+}
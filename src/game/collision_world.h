@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/rect.h"
+
+/**
+ * Broad-phase collision over a uniform grid laid across the field.
+ *
+ * Bodies are axis-aligned boxes in floating point (as in `BodyStore`),
+ * re-added every tick and binned into each grid cell they touch; bodies
+ * beyond the field land in the border cells. Only bodies sharing a cell are
+ * compared, so finding overlaps stays near-linear in the number of bodies
+ * as long as they are small relative to the field and spread over it,
+ * instead of comparing every pair.
+ *
+ * Once per tick:
+ *
+ *     world.clear();
+ *     world.add(...); ...
+ *     world.build();
+ *     world.findPairs(pairs);  // and/or
+ *     world.query(area, hits);
+ *
+ * Overlap follows `Rect` (Minkowski difference) semantics: touching edges
+ * do not overlap.
+ *
+ * TODO: Tests
+ */
+class CollisionWorld {
+  public:
+    /** Bodies are numbered in the order they were added, from zero. */
+    using Id = uint32_t;
+
+    struct Config {
+        Rect field;
+        /**
+         * Grid cell edge length, in pixels. Around the size of a typical
+         * body works best: much smaller and bodies span many cells, much
+         * larger and cells hold many unrelated bodies. Values below one are
+         * taken as one.
+         */
+        int cellSize{16};
+    };
+
+    /** Two overlapping bodies, with `a < b`. */
+    struct Pair {
+        Id a;
+        Id b;
+    };
+
+    CollisionWorld(const Config& config);
+
+    // --- Bodies
+
+    /**
+     * Remove every body (keeping allocations for the next tick).
+     */
+    void clear();
+
+    /**
+     * Add a body. It is not visible to queries until the next `build`.
+     */
+    Id add(float x, float y, float w, float h);
+
+    /**
+     * Bin all bodies into the grid.
+     */
+    void build();
+
+    std::size_t size() const;
+
+    // --- Queries (valid after `build`)
+
+    /**
+     * Append every overlapping pair of bodies to `pairs`, each once.
+     */
+    void findPairs(std::vector<Pair>& pairs) const;
+
+    /**
+     * Append every body overlapping `area` to `hits`, each once.
+     */
+    void query(const Rect& area, std::vector<Id>& hits) const;
+
+    // --- Access
+
+    int getColumns() const;
+    int getRows() const;
+
+  private:
+    /**
+     * A body's edges, the first grid cell it covers, and its Id. Copied
+     * into every cell the body covers, so that scanning a cell reads one
+     * contiguous run of memory.
+     */
+    struct Entry {
+        float left;
+        float top;
+        float right;
+        float bottom;
+        int16_t minColumn;
+        int16_t minRow;
+        Id id;
+    };
+
+    /** Inclusive range of cells covered by a box. */
+    struct Span {
+        int minColumn;
+        int minRow;
+        int maxColumn;
+        int maxRow;
+    };
+
+    // --- Grid
+    float originX;
+    float originY;
+    /** `Config::cellSize`, at least one. */
+    int cellSize;
+    float inverseCellSize;
+    int columns;
+    int rows;
+
+    // --- Bodies (indexed by Id)
+    std::vector<Entry> bodies;
+    std::vector<Span> spans;
+
+    // --- Cells
+    // Entries of cell `c` are `cellEntries[cellStart[c]] .. [cellStart[c + 1]]`,
+    // in ascending Id order.
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellCursor;
+    std::vector<Entry> cellEntries;
+
+    Span getSpan(float left, float top, float right, float bottom) const;
+};
@@ -1,3 +1,6 @@
+#include <array>
+#include <cmath>
+
 #include "ball.h"
 
 #include "core/color.h"
@@ -11,6 +14,31 @@ Ball::Ball() { setSize(8, 8); }
 // -----------------------------------------------------------------------------
 // Static Function Components
 // -----------------------------------------------------------------------------
+// Launch angles are `-40 + (a + b) / 4` degrees for uniform a in [0, 320] and
+// b in [0, 40]: a quarter-degree grid with a trapezoidal spread, like the
+// earlier `80 * (u - 0.5) + 10 * v`. The table holds the resulting velocity
+// components at the default speed, so serves need no trig.
+static const int launchAngleSteps{4};
+static const uint32_t launchSpreadA{80 * launchAngleSteps + 1};
+static const uint32_t launchSpreadB{10 * launchAngleSteps + 1};
+
+struct Launch {
+    float vx;
+    float vy;
+};
+using LaunchTable = std::array<Launch, launchSpreadA + launchSpreadB - 1>;
+
+static LaunchTable makeLaunchTable(double speed) {
+    LaunchTable launches;
+    for (std::size_t idx = 0; idx < launches.size(); ++idx) {
+        const double degrees{-40 + static_cast<double>(idx) / launchAngleSteps};
+        const double radians{degrees * M_PI / 180};
+        launches[idx] = {static_cast<float>(std::cos(radians) * speed),
+                         static_cast<float>(std::sin(radians) * speed)};
+    }
+    return launches;
+}
+
 static void renderWhiteRect(Rect const& rect) {
     static auto const& renderer{Renderer::get()};
     renderer.drawRect(rect, Color::white());
@@ -20,20 +48,20 @@ static void renderWhiteRect(Rect const& rect) {
 // Entity Overrides
 // -----------------------------------------------------------------------------
 void Ball::update(float delta) { move(delta); }
-void Ball::draw() const { renderWhiteRect(getRect()); }
+void Ball::draw(float alpha) const { renderWhiteRect(getInterpolatedRect(alpha)); }
 
 // -----------------------------------------------------------------------------
 // Member Functions
 // -----------------------------------------------------------------------------
-void Ball::randomizeVelocity() {
-    double degrees = 80 * ((double)rand() / (double)RAND_MAX - 0.5) +
-                     (10 * ((double)rand() / (double)RAND_MAX));
-    double radians = degrees * M_PI / 180;
+void Ball::randomizeVelocity(Random& random) {
+    static const LaunchTable launchTable{makeLaunchTable(defaultSpeed)};
+    const uint32_t angle{random.nextBelow(launchSpreadA) +
+                         random.nextBelow(launchSpreadB)};
+    const Launch& launch{launchTable[angle]};
 
-    int xDirection = ((float)rand() / (float)RAND_MAX) < 0.5 ? -1 : 1;
-    int yDirection = ((float)rand() / (float)RAND_MAX) < 0.5 ? -1 : 1;
+    const float xDirection{random.nextBool() ? -1.0f : 1.0f};
+    const float yDirection{random.nextBool() ? -1.0f : 1.0f};
 
-    int vx = (int)floor(cos(radians) * xDirection * defaultSpeed);
-    int vy = (int)floor(sin(radians) * yDirection * defaultSpeed);
-    setVelocity(vx, vy);
+    setVelocity(static_cast<int>(std::floor(launch.vx * xDirection)),
+                static_cast<int>(std::floor(launch.vy * yDirection)));
 }
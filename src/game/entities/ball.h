@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/random.h"
 #include "game/entity.h"
 
 // TODO: Tests
@@ -7,9 +8,13 @@ class Ball : public Entity {
   public:
     Ball();
     void update(float delta) override;
-    void draw() const override;
+    void draw(float alpha) const override;
 
-    void randomizeVelocity();
+    /**
+     * Launch at the default speed, 40 degrees below to 50 above horizontal
+     * (angles near the middle are likelier), left or right, up or down.
+     */
+    void randomizeVelocity(Random& random);
 
   private:
     double speed{0};
@@ -1,4 +1,7 @@
+#include <stdexcept>
+
 #include "countdown.h"
+#include "core/color.h"
 #include "core/renderer.h"
 
 // -----------------------------------------------------------------------------
@@ -32,13 +35,13 @@ static SignedTicks getResetTicks(Count startingCount, SignedTicks interval) {
 // Constructor
 // -----------------------------------------------------------------------------
 Countdown::Countdown(CountType startingCount, SignedTicks interval,
-                     TextureContainerType const& textures, CallbackType onTimeout,
-                     Vector2 position)
+                     GlyphAtlas const& atlas, LabelContainerType const& labels,
+                     CallbackType onTimeout, Vector2 position)
     : startingCount{startingCount},
       currentTicks{getResetTicks(startingCount, interval)}, interval{interval},
-      textures{textures}, timeoutCallback{onTimeout} {
-    if (textures.size() < startingCount) {
-        throw std::length_error("given texture vector is smaller than required "
+      atlas{&atlas}, labels{labels}, timeoutCallback{onTimeout} {
+    if (labels.size() < startingCount) {
+        throw std::length_error("given label vector is smaller than required "
                                 "by given starting count!");
     }
     setPosition(position.x, position.y);
@@ -58,10 +61,11 @@ void Countdown::update(float const delta) {
     }
 }
 
-void Countdown::draw() const {
+void Countdown::draw(float alpha) const {
+    (void)alpha;
     static auto const& renderer{Renderer::get()};
     auto const pos{getPosition()};
-    renderer.drawTexture(*textures[currentCount], pos.x, pos.y);
+    renderer.drawText(*atlas, labels[currentCount], pos.x, pos.y, Color::white());
 }
 
 // -----------------------------------------------------------------------------
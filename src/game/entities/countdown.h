@@ -1,10 +1,10 @@
 #pragma once
 
 #include <functional>
-#include <memory>
+#include <string>
 #include <vector>
 
-#include "core/texture.h"
+#include "core/glyph_atlas.h"
 #include "core/vector2.h"
 #include "game/entity.h"
 
@@ -15,21 +15,22 @@ class Countdown : public Entity {
   public:
     using SignedTicks          = int64_t;
     using CountType            = unsigned short;
-    using TextureContainerType = std::vector<std::shared_ptr<Texture>>;
+    using LabelContainerType   = std::vector<std::string>;
     using CallbackType =
         std::function<void()>; // could be optimized via. template parameter
 
     Countdown(CountType startingNumber, SignedTicks interval,
-              TextureContainerType const& textures, CallbackType onTimeout,
-              Vector2 position);
+              GlyphAtlas const& atlas, LabelContainerType const& labels,
+              CallbackType onTimeout, Vector2 position);
     void update(const float delta) override;
-    void draw() const override;
+    void draw(float alpha) const override;
 
   private:
     CountType startingCount;
     CountType currentCount;
     SignedTicks currentTicks;
     SignedTicks interval;
-    TextureContainerType textures;
+    GlyphAtlas const* atlas;
+    LabelContainerType labels;
     CallbackType timeoutCallback;
 };
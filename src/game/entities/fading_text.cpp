@@ -9,7 +9,7 @@
 // -----------------------------------------------------------------------------
 
 FadingText::FadingText(const Font& font, const std::string& text, Vector2 position)
-    : texture{Renderer::get().loadTexture(font, text, Color::white())} {
+    : texture{Renderer::get().getTexture(font, text, Color::white())} {
     setPosition(position.x, position.y);
 }
 
@@ -27,11 +27,13 @@ void FadingText::update(float delta) {
     }
     // Animation Driver
     anim.alpha += anim.velocity * delta;
-    texture.setAlpha(anim.alpha);
 }
 
-void FadingText::draw() const {
+void FadingText::draw(float alpha) const {
+    (void)alpha;
     static const Renderer& renderer{Renderer::get()};
     Vector2 pos{getPosition()};
-    renderer.drawTexture(texture, pos.x, pos.y);
+    // The texture may be shared, so its alpha is set as it is drawn.
+    texture->setAlpha(anim.alpha);
+    renderer.drawTexture(*texture, pos.x, pos.y);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 #include "core/font.h"
@@ -24,7 +25,7 @@ class FadingText : public Entity {
 
     // --- Entity Overrides
     void update(float delta) override;
-    void draw() const override;
+    void draw(float alpha) const override;
 
   private:
     // --- Types
@@ -35,7 +36,8 @@ class FadingText : public Entity {
     };
 
     // --- Data Members
-    Texture texture;
+    /** Shared through the renderer's texture cache. */
+    std::shared_ptr<Texture> texture;
 
     AnimationData anim;
 };
@@ -9,8 +9,17 @@ class Paddle : public Entity {
     Paddle(Player player);
 
     void update(float delta) override;
-    void draw() const override;
+    void draw(float alpha) const override;
+
+    /**
+     * Set the steering direction used by subsequent updates.
+     * -1 is full speed up, 1 is full speed down, 0 is at rest.
+     */
+    void steer(float direction);
+
+    Player getPlayer() const;
 
   private:
     Player player;
+    float direction{0};
 };
@@ -11,17 +11,20 @@
 
 Score::~Score() {}
 
-Score::Score(const Params params)
-    : max{params.max}, textures{createIntegerTextureVector(params.font, params.max)} {}
+Score::Score(const Params params) : max{params.max}, atlas{params.atlas} {}
 
 // -----------------------------------------------------------------------------
 // Entity Overrides
 // -----------------------------------------------------------------------------
 
-void Score::draw() const {
+void Score::draw(float alpha) const {
+    (void)alpha;
+    if (!atlas) {
+        return;
+    }
     static const Renderer& renderer{Renderer::get()};
     Vector2 pos{getPosition()};
-    renderer.drawTexture(textures[value], pos.x, pos.y);
+    renderer.drawText(*atlas, std::to_string(value), pos.x, pos.y, Color::white());
 }
 
 // -----------------------------------------------------------------------------
@@ -39,20 +42,4 @@ void Score::increment() {
 }
 void Score::reset() { value = 0; }
 bool Score::isAtMax() { return (value == max); }
-
-// -----------------------------------------------------------------------------
-// Private Utilities
-// -----------------------------------------------------------------------------
-
-std::vector<Texture> Score::createIntegerTextureVector(const Font& font,
-                                                       ValueType limit) {
-    const Renderer& renderer{Renderer::get()};
-    const SDL_Color white{Color::white()};
-    std::vector<Texture> textures;
-    textures.reserve(limit);
-    // Technically allow for limit "plus one"
-    for (auto idx = 0; idx <= limit; ++idx) {
-        textures.emplace_back(renderer.loadTexture(font, std::to_string(idx), white));
-    }
-    return textures;
-}
+Score::ValueType Score::getValue() const { return value; }
@@ -1,8 +1,6 @@
 #pragma once
 
-#include <vector>
-
-#include "core/texture.h"
+#include "core/glyph_atlas.h"
 #include "game/entity.h"
 
 // TODO: Tests
@@ -13,7 +11,8 @@ class Score : public Entity {
 
     /** Option Parameters */
     struct Params {
-        const Font& font;
+        /** Glyphs used to draw the score. May be null (headless; never drawn). */
+        const GlyphAtlas* atlas;
         ValueType max;
     };
 
@@ -34,20 +33,15 @@ class Score : public Entity {
     // --- Virtual Implementations
     // TODO: Implement at max handler and notify here.
     void update(float delta) override { (void)delta; };
-    void draw() const override;
+    void draw(float alpha) const override;
 
     // --- Public API
     void increment();
     void reset();
     bool isAtMax();
+    ValueType getValue() const;
 
   private:
-    static std::vector<Texture> createIntegerTextureVector(const Font& font,
-                                                           ValueType count);
-
-    // NOTE: Candidate for string-texture caching example,
-    //       such as an unordered map + LRU cache.
-
     /**
      * Maximum score, inclusive.
      *
@@ -56,8 +50,8 @@ class Score : public Entity {
      */
     ValueType max;
 
-    /** Integer-texture vector reference used to draw the score */
-    std::vector<Texture> textures;
+    /** Glyphs used to draw the score (not owned). */
+    const GlyphAtlas* atlas;
 
     /**
      * Current score as an unsigned integer.
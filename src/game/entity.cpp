@@ -1,41 +1,57 @@
 #include "entity.h"
 
 const Vector2 Entity::getPosition() const {
-    return Vector2{aabb.x - (aabb.w / 2), aabb.y - (aabb.h / 2)};
+    const Vector2 topLeft{position.toVector2()};
+    return Vector2{topLeft.x - (size.x / 2), topLeft.y - (size.y / 2)};
 }
 
 void Entity::setPosition(int x, int y) {
-    aabb.x = x - (aabb.w / 2);
-    aabb.y = y - (aabb.h / 2);
+    position = FixedVector2{Vector2{x - (size.x / 2), y - (size.y / 2)}};
+    snapshot();
 }
 
-int Entity::getLeftEdgePosition() const { return aabb.x; }
-void Entity::setLeftEdgePosition(int x) { aabb.x = x; }
+const FixedVector2 Entity::getFixedTopLeft() const { return position; }
 
-int Entity::getTopEdgePosition() const { return aabb.y; }
-void Entity::setTopEdgePosition(int y) { aabb.y = y; }
+int Entity::getLeftEdgePosition() const { return position.x.toInt(); }
+void Entity::setLeftEdgePosition(int x) { position.x = Fixed::fromInt(x); }
 
-int Entity::getRightEdgePosition() const { return aabb.x + aabb.w; }
-void Entity::setRightEdgePosition(int x) { aabb.x = x - aabb.w; }
+int Entity::getTopEdgePosition() const { return position.y.toInt(); }
+void Entity::setTopEdgePosition(int y) { position.y = Fixed::fromInt(y); }
 
-int Entity::getBottomEdgePosition() const { return aabb.y + aabb.h; }
-void Entity::setBottomEdgePosition(int y) { aabb.y = y - aabb.h; }
+int Entity::getRightEdgePosition() const { return position.x.toInt() + size.x; }
+void Entity::setRightEdgePosition(int x) { position.x = Fixed::fromInt(x - size.x); }
 
-const Vector2 Entity::getSize() const { return Vector2{aabb.w, aabb.h}; }
+int Entity::getBottomEdgePosition() const { return position.y.toInt() + size.y; }
+void Entity::setBottomEdgePosition(int y) { position.y = Fixed::fromInt(y - size.y); }
+
+const Vector2 Entity::getSize() const { return size; }
 void Entity::setSize(int w, int h) {
-    aabb.w = w;
-    aabb.h = h;
+    size.x = w;
+    size.y = h;
 }
 
-const Vector2 Entity::getVelocity() const { return velocity; }
-void Entity::setVelocity(int vx, int vy) {
-    velocity.x = vx;
-    velocity.y = vy;
+const Vector2 Entity::getVelocity() const { return velocity.toVector2(); }
+void Entity::setVelocity(int vx, int vy) { velocity = FixedVector2{Vector2{vx, vy}}; }
+
+const FixedVector2 Entity::getFixedVelocity() const { return velocity; }
+void Entity::setFixedVelocity(const FixedVector2& velocity) {
+    this->velocity = velocity;
 }
 
-void Entity::move(float delta) {
-    aabb.x += std::round(velocity.x * delta);
-    aabb.y += std::round(velocity.y * delta);
+void Entity::move(float delta) { translate(velocity * Fixed::fromFloat(delta)); }
+
+void Entity::translate(const FixedVector2& offset) { position = position + offset; }
+
+const Rect Entity::getRect() const {
+    const Vector2 topLeft{position.toVector2()};
+    return Rect{topLeft.x, topLeft.y, size.x, size.y};
 }
 
-const Rect Entity::getRect() const { return aabb; }
+void Entity::snapshot() { previousPosition = position; }
+
+const Rect Entity::getInterpolatedRect(float alpha) const {
+    const FixedVector2 blended{previousPosition +
+                               (position - previousPosition) * Fixed::fromFloat(alpha)};
+    const Vector2 topLeft{blended.toVector2()};
+    return Rect{topLeft.x, topLeft.y, size.x, size.y};
+}
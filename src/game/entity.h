@@ -24,8 +24,11 @@ class Entity {
     /**
      * Override this to describe how the entity is to behave during the
      * "rendering" phase.
+     *
+     * `alpha` is the interpolation factor between the previous and the
+     * current simulation state (see `getInterpolatedRect`).
      */
-    virtual void draw() const = 0;
+    virtual void draw(float alpha) const = 0;
 
     // ---------------------------------
     // Position
@@ -38,9 +41,18 @@ class Entity {
 
     /**
      * Set the position of the entity.
+     *
+     * This is a "teleport": the previous simulation state is moved along
+     * with it, so no interpolation happens across the jump.
      */
     void setPosition(int x, int y);
 
+    /**
+     * Get the position of the entity's top-left corner, with sub-pixel
+     * precision.
+     */
+    const FixedVector2 getFixedTopLeft() const;
+
     /**
      * Get the horizontal position of the entity's left edge.
      */
@@ -109,22 +121,59 @@ class Entity {
      */
     void setVelocity(int vx, int vy);
 
+    /**
+     * Get the entity's velocity, with sub-pixel precision.
+     */
+    const FixedVector2 getFixedVelocity() const;
+
+    /**
+     * Set the entity's velocity, with sub-pixel precision.
+     */
+    void setFixedVelocity(const FixedVector2& velocity);
+
     /**
      * Change the entity's position based on it's current velocity.
      * NOTE: Doesn't belong with entity.
      */
     void move(float delta);
 
+    /**
+     * Move the entity by `offset`. Unlike `setPosition`, this is motion:
+     * it is interpolated when drawn.
+     */
+    void translate(const FixedVector2& offset);
+
     // ---------------------------------
     // Rect Access
     // ---------------------------------
 
     /**
-     * Get a constant `Rect` describing the entity's geometry.
+     * Get a constant `Rect` describing the entity's geometry, rounded to
+     * whole pixels.
      */
     const Rect getRect() const;
 
+    // ---------------------------------
+    // Interpolation
+    // ---------------------------------
+
+    /**
+     * Record the current geometry as the previous simulation state.
+     * Call once at the start of every simulation tick.
+     */
+    void snapshot();
+
+    /**
+     * Get a `Rect` blended between the previous simulation state (`alpha` of
+     * 0) and the current one (`alpha` of 1). Used for rendering only.
+     */
+    const Rect getInterpolatedRect(float alpha) const;
+
   private:
-    Velocity velocity{0, 0};
-    Rect aabb{0, 0, 0, 0};
+    // Simulation state is fixed-point (see `Fixed`); whole-pixel `Rect`s are
+    // only produced on the way out, for collision tests and drawing.
+    FixedVector2 velocity;
+    FixedVector2 position;
+    FixedVector2 previousPosition;
+    Vector2 size;
 };
@@ -1,10 +1,13 @@
 #include <cassert>
 
+#include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
 #include "SDL_scancode.h"
+#include "SDL_timer.h"
 
 #include "core/color.h"
+#include "core/profiler.h"
 #include "game.h"
 #include "game/entities/countdown.h"
 #include "game/entities/fading_text.h"
@@ -14,40 +17,43 @@
 // Constructor / Destructor
 // -----------------------------------------------------------------------------
 
-Game::Game(const App::Config& config)
-    : App{config},
+Game::Hud::Hud(const Rect& field, Countdown::CallbackType onCountdownDone)
+    : font{"res/font.ttf", 16}, atlas{Renderer::get().loadGlyphAtlas(font)},
+      pressStartText{font, "PRESS START", field.getCenter()},
+      pauseText{font, "PAUSED", field.getCenter()},
+      gameOverText{font, "GAME OVER", field.getCenter() - Vector2{0, 16}},
+      resetText{font, "Press START to play again", field.getCenter() + Vector2{0, 16}},
+      countdown{3, 600, atlas, {"GO!", "1", "2", "3"}, onCountdownDone,
+                field.getCenter()} {}
+
+Game::Game(const Config& config)
+    : App{config.app},
+      // The field is the logical size when there is one, not the window's.
       field{
           0,
           0,
-          static_cast<int>(config.display.windowWidth),
-          static_cast<int>(config.display.windowHeight),
+          static_cast<int>(config.app.renderer.logicalWidth
+                               ? config.app.renderer.logicalWidth
+                               : config.app.display.windowWidth),
+          static_cast<int>(config.app.renderer.logicalHeight
+                               ? config.app.renderer.logicalHeight
+                               : config.app.display.windowHeight),
       },
-      leftPaddle{Player::one}, rightPaddle{Player::two}, ball{},
-      currentState{&startState}, font{"res/font.ttf", 16},
-      leftScore{{.font = font, .max = Game::maxScore}},
-      rightScore{{.font = font, .max = Game::maxScore}} {
-
-    // ---------------------------------
-    // Entities
-    // ---------------------------------
-    {
-        const Vector2 ratio{6, 24};
-        const Vector2 fieldCenter{field.getCenter()};
-        ball.setPosition(fieldCenter.x, fieldCenter.y);
-        ball.setVelocity(0, 0);
-
-        // Left Player Paddle (player 1)
-        leftPaddle.setPosition(field.w / ratio.x, fieldCenter.y);
-
-        // Right Player Paddle (player 2)
-        rightPaddle.setPosition(field.w - (field.w / ratio.x), fieldCenter.y);
-
-        // Left Score
-        leftScore.setPosition(fieldCenter.x - (field.w / ratio.x), field.h / ratio.y);
-
-        // Right Score
-        rightScore.setPosition(fieldCenter.x + (field.w / ratio.x), field.h / ratio.y);
-    }
+      hud{config.app.headless ? nullptr
+                              : std::make_unique<Hud>(field, [this]() { next(); })},
+      matchConfig{
+          .field           = field,
+          .leftPilot       = config.leftPilot,
+          .rightPilot      = config.rightPilot,
+          .maxScore        = Game::maxScore,
+          .atlas           = hud ? &hud->atlas : nullptr,
+          .chaosBalls      = config.chaosBalls,
+          .chaosCollisions = config.chaosCollisions,
+          .obstacles       = config.obstacles,
+      },
+      match{matchConfig}, matchLimit{config.matchLimit},
+      replayFile{config.replayFile}, tickRate{config.app.tickRate},
+      isTracingTransitions{config.traceTransitions} {
 
     // ---------------------------------
     // Sub-system Intitialization
@@ -68,6 +74,31 @@ Game::Game(const App::Config& config)
                                         InputBus::Action::cancel);
         config.setKeyboardKeyDownAction(SDL_SCANCODE_P, InputBus::Action::pause);
         config.setKeyboardKeyDownAction(SDL_SCANCODE_Q, InputBus::Action::quit);
+        config.setKeyboardKeyDownAction(SDL_SCANCODE_F3, InputBus::Action::toggleStats);
+
+        // Either player's controller: D-pad or left stick to move, A to
+        // start, B to cancel, Start to pause.
+        using Action        = InputBus::Action;
+        using AxisDirection = InputBus::AxisDirection;
+        for (Player player : {Player::one, Player::two}) {
+            const bool isOne{player == Player::one};
+            const Action up{isOne ? Action::playerOneUp : Action::playerTwoUp};
+            const Action down{isOne ? Action::playerOneDown : Action::playerTwoDown};
+            config.setControllerButtonDownAction(player, SDL_CONTROLLER_BUTTON_DPAD_UP,
+                                                 up);
+            config.setControllerButtonDownAction(player,
+                                                 SDL_CONTROLLER_BUTTON_DPAD_DOWN, down);
+            config.setControllerAxisAction(player, SDL_CONTROLLER_AXIS_LEFTY,
+                                           AxisDirection::negative, up);
+            config.setControllerAxisAction(player, SDL_CONTROLLER_AXIS_LEFTY,
+                                           AxisDirection::positive, down);
+            config.setControllerButtonDownAction(player, SDL_CONTROLLER_BUTTON_A,
+                                                 Action::confirm);
+            config.setControllerButtonDownAction(player, SDL_CONTROLLER_BUTTON_B,
+                                                 Action::cancel);
+            config.setControllerButtonDownAction(player, SDL_CONTROLLER_BUTTON_START,
+                                                 Action::pause);
+        }
 
         input.initialize(config);
 
@@ -82,220 +113,90 @@ Game::Game(const App::Config& config)
             case InputBus::Action::confirm:
                 confirm();
                 return;
+            case InputBus::Action::toggleStats:
+                isStatsOverlayVisible = !isStatsOverlayVisible;
+                return;
             default:
                 return;
             }
         });
     }
+}
+Game::~Game() {}
 
-    // ---------------------------------
-    // State Transitions
-    // ---------------------------------
-
-    // --- Start
-    startState.onConfirm = &fieldSetupState;
-    startState.onQuit    = &shutdownState;
-
-    // --- Reset
-    resetState.onNext = &fieldSetupState;
-    resetState.onQuit = &shutdownState;
-
-    // --- Field Setup
-    fieldSetupState.onNext = &countdownState;
-    fieldSetupState.onQuit = &shutdownState;
-
-    // --- Countdown
-    countdownState.onNext = &playingState;
-    countdownState.onQuit = &shutdownState;
-
-    // --- Playing
-    playingState.onPause    = &pauseState;
-    playingState.onNext     = &fieldSetupState;
-    playingState.onGameOver = &gameOverState;
-    playingState.onQuit     = &shutdownState;
-
-    // --- Pause
-    pauseState.onPause = &playingState;
-    pauseState.onQuit  = &shutdownState;
+// -----------------------------------------------------------------------------
+// Frame / Event Processing Dispatch
+// -----------------------------------------------------------------------------
 
-    // --- Game Over
-    gameOverState.onConfirm = &resetState;
-    gameOverState.onCancel  = &shutdownState;
-    gameOverState.onQuit    = &shutdownState;
+void Game::simulate(const float delta) {
+    drainTransitions();
+    // One input snapshot per tick; everything this tick reads it.
+    InputBus::get().updateActionState();
+    (this->*getDescription(currentState).simulate)(delta);
+}
+void Game::render(const float alpha) {
+    (this->*getDescription(currentState).render)(alpha);
+}
 
-    // ---------------------------------
-    // State Execution Controls
-    // ---------------------------------
+const Match::Statistics& Game::getStatistics() const {
+    return match.getStatistics();
+}
 
-    // --- Start
-    startState.processFrame = [this](const float delta) {
-        static auto const& renderer{Renderer::get()};
-        static FadingText pressStartText{font, "PRESS START", field.getCenter()};
-        pressStartText.update(delta); // drive animation
-        renderer.clear();
-        pressStartText.draw();
-        renderer.show();
-    };
-
-    // --- Reset
-    resetState.enter = [this]() {
-        leftScore.reset();
-        rightScore.reset();
-        next();
-    };
-    resetState.processFrame = [](const float delta) { (void)delta; };
+bool Game::isHeadless() const { return !hud; }
 
-    // --- Countdown
-    // TODO: Move to Countdown entity
+bool Game::isRecording() const { return !replayFile.empty(); }
 
-    countdownState.processFrame = [this](const float delta) {
-        // --- Renderer
-        static const Renderer& renderer{Renderer::get()};
+void Game::startMatch() {
+    isMatchStarting = false;
 
-        static auto const createNumberTexture = [this](int number) -> Texture {
-            return renderer.loadTexture(font, std::to_string(number), Color::white());
-        };
+    // A fresh seed per match; recorded, so the match can be replayed.
+    const uint64_t seed{SDL_GetPerformanceCounter()};
+    match.reseed(seed);
 
-        static auto const createStringTexture =
-            [this](char const* const text) -> Texture {
-            return renderer.loadTexture(font, text, Color::white());
+    if (isRecording()) {
+        replay = Replay{
+            .tickRate = tickRate,
+            .match    = matchConfig,
         };
-
-        static Countdown countdown{
-            3,
-            600,
-            {std::make_shared<Texture>(createStringTexture("GO!")),
-             std::make_shared<Texture>(createNumberTexture(1)),
-             std::make_shared<Texture>(createNumberTexture(2)),
-             std::make_shared<Texture>(createNumberTexture(3))},
-            [this]() { next(); },
-            field.getCenter()};
-
-        countdown.update(delta);
-
-        // --- Rendering
-        renderer.clear();
-        // Draw paddles for "visual effect"
-        leftPaddle.draw();
-        rightPaddle.draw();
-        leftScore.draw();
-        rightScore.draw();
-        countdown.draw();
-        renderer.show();
-    };
-
-    // --- Field Setup
-    fieldSetupState.enter = [this]() {
-        Vector2 fieldCenter{field.getCenter()};
-        ball.setPosition(fieldCenter.x, fieldCenter.y);
-        ball.randomizeVelocity();
-        next();
-    };
-    fieldSetupState.processFrame = [](const float delta) { (void)delta; };
-
-    // --- Playing
-    playingState.processFrame = [this](const float delta) {
-        static const Renderer& render{Renderer::get()};
-
-        // --- Update
-
-        ball.update(delta);
-        leftPaddle.update(delta);
-        rightPaddle.update(delta);
-
-        // --- Collide
-
-        resolveFrameCollisions();
-
-        // --- Render
-
-        render.clear();
-
-        ball.draw();
-        leftPaddle.draw();
-        rightPaddle.draw();
-        leftScore.draw();
-        rightScore.draw();
-
-        render.show();
-    };
-
-    // --- Pause
-    pauseState.processFrame = [this](const float delta) {
-        static auto const& renderer{Renderer::get()};
-        static FadingText pauseText{font, "PAUSED", field.getCenter()};
-        pauseText.update(delta); // drive animation
-        renderer.clear();
-        pauseText.draw();
-        leftPaddle.draw();
-        rightPaddle.draw();
-        leftScore.draw();
-        rightScore.draw();
-        renderer.show();
-    };
-
-    // --- Game Over
-    gameOverState.processFrame = [this](const float delta) {
-        static auto const& renderer{Renderer::get()};
-        static FadingText gameOverText{font, "GAME OVER",
-                                       field.getCenter() - Vector2{0, 16}};
-        static FadingText resetText{font, "Press START to play again",
-                                    field.getCenter() + Vector2{0, 16}};
-        gameOverText.update(delta); // drive animation
-        resetText.update(delta);
-        renderer.clear();
-        gameOverText.draw();
-        resetText.draw();
-        renderer.show();
-    };
-
-    // --- Shut Down
-    shutdownState.enter        = [this]() { stop(); };
-    shutdownState.exit         = []() {};
-    shutdownState.processFrame = [](const float delta) { (void)delta; };
-
-// ---------------------------------
-// State Member Assertions (debug)
-// ---------------------------------
-// Just check to make sure state->processFrame and state->processEvent
-// are both defined, these are just pseudo-assertions to make sure I
-// didn't forget to define anything, they should be removed in release
-// builds.
-#ifndef NDEBUG
-    State* debugStateAssertionChecklist[]{
-        &startState, &resetState,     &fieldSetupState, &playingState,
-        &pauseState, &countdownState, &shutdownState,   &gameOverState};
-
-    bool error = false;
-
-    for (State* state : debugStateAssertionChecklist) {
-        bool frameproc_error{false};
-        if ((frameproc_error = !state->processFrame)) {
-            spdlog::error("{} state does not define a frame processor!", state->tag);
-        }
-
-        error |= frameproc_error;
+        replay.match.atlas = nullptr;
+        replay.match.seed  = seed;
     }
+}
 
-    if (error) {
-        abort();
+void Game::drawChaosBalls(float alpha) const {
+    static const Renderer& renderer{Renderer::get()};
+    const BodyStore& bodies{match.getChaosBalls()};
+    const SDL_Color white{Color::white()};
+    for (BodyStore::Index idx = 0; idx < bodies.size(); ++idx) {
+        renderer.drawRect(bodies.getInterpolatedRect(idx, alpha), white);
+    }
+}
+void Game::drawObstacles() const {
+    static const Renderer& renderer{Renderer::get()};
+    for (const Rect& obstacle : match.getObstacles()) {
+        renderer.drawRect(obstacle, Color::white());
     }
-
-#endif
 }
-Game::~Game() { InputBus::get().offActionPressed(actionSubscription); }
-
-// -----------------------------------------------------------------------------
-// Frame / Event Processing Dispatch
-// -----------------------------------------------------------------------------
 
-void Game::processFrame(const float delta) {
-    if (!transitionQueue.empty()) {
-        handleTransition(transitionQueue.front());
-        transitionQueue.pop();
+void Game::drawStatsOverlay() const {
+    if (!isStatsOverlayVisible) {
+        return;
     }
-    currentState->processFrame(delta);
+    static const Renderer& renderer{Renderer::get()};
+    // Only changes when the summary does, a few times a second.
+    const FrameStats::Summary& stats{getFrameStats().getSummary()};
+    const int lineHeight{hud->atlas.lineHeight};
+    const int x{static_cast<int>(field.getCenter().x)};
+    const int y{field.y + field.h - (lineHeight * 2)};
+    renderer.drawText(hud->atlas,
+                      fmt::format("{:.0f} FPS  p99 {:.1f}ms", stats.fps, stats.p99), x,
+                      y, Color::white());
+    renderer.drawText(hud->atlas,
+                      fmt::format("{:.0f} calls {:.0f} binds", stats.drawCalls,
+                                  stats.textureBinds),
+                      x, y + lineHeight, Color::white());
 }
+
 void Game::processEvent(const SDL_Event& event) {
     // Primary switch for system events.
     switch (event.type) {
@@ -305,123 +206,268 @@ void Game::processEvent(const SDL_Event& event) {
     case SDL_MOUSEBUTTONDOWN:
         InputBus::get().handleMouseButtonDownEvent(event.button);
         break;
+    case SDL_CONTROLLERDEVICEADDED:
+    case SDL_CONTROLLERDEVICEREMOVED:
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+    case SDL_CONTROLLERAXISMOTION:
+        InputBus::get().handleControllerEvent(event);
+        break;
     default:
         break;
     }
 }
 
 // -----------------------------------------------------------------------------
-// Trigger-to-State Dispatch
+// States
 // -----------------------------------------------------------------------------
 
-// TODO: Generalize Event Bus
-void Game::scheduleTransition(State* target) {
-    if (target) {
-        transitionQueue.push(target);
-    }
+constexpr Game::StateDescription Game::stateDescriptions[stateCount]{
+    // Indexed by `State`; keep in declaration order.
+    {"Start", &Game::simulateStart, &Game::renderStart, nullptr, nullptr},
+    {"Reset", &Game::simulateNothing, &Game::renderNothing, &Game::enterReset,
+     nullptr},
+    {"Countdown", &Game::simulateCountdown, &Game::renderCountdown,
+     &Game::enterCountdown, nullptr},
+    {"Field Setup", &Game::simulateNothing, &Game::renderNothing,
+     &Game::enterFieldSetup, nullptr},
+    {"Playing", &Game::simulatePlaying, &Game::renderPlaying, nullptr, nullptr},
+    {"Pause", &Game::simulatePause, &Game::renderPause, nullptr, nullptr},
+    {"Game Over", &Game::simulateGameOver, &Game::renderGameOver,
+     &Game::enterGameOver, nullptr},
+    {"Shutdown", &Game::simulateNothing, &Game::renderNothing,
+     &Game::enterShutdown, nullptr},
+};
+
+const Game::StateDescription& Game::getDescription(State state) const {
+    // Here rather than in the class, which must be complete to evaluate them.
+    static_assert(canQuitFromEveryState(), "Every state must handle quit");
+    static_assert(isEveryStateReachable(), "Every state must be reachable from start");
+    static_assert(
+        [] {
+            for (const StateDescription& description : stateDescriptions) {
+                if (!description.simulate || !description.render) {
+                    return false;
+                }
+            }
+            return true;
+        }(),
+        "Every state must define a simulation step and a renderer");
+
+    return stateDescriptions[static_cast<std::size_t>(state)];
 }
 
-void Game::handleTransition(State* target) {
-    // If `target` is defined (a transition exists for the proved event)
-    // - see specific event callers for example.
-    if (target) {
-        // Call the exit handler of the old state, if the handler exists
-        if (currentState->exit) {
-            currentState->exit();
-        }
-        // Transition to the target state provided by the caller
-        currentState = target;
-        // Call the enter handler of the new state, if the handler exists
-        if (currentState->enter) {
-            currentState->enter();
-        }
+void Game::simulateNothing(const float delta) { (void)delta; }
+void Game::renderNothing(const float alpha) { (void)alpha; }
+
+// --- Start
+void Game::simulateStart(const float delta) {
+    // Nobody to press START when headless.
+    if (isHeadless()) {
+        confirm();
+        return;
     }
+    hud->pressStartText.update(delta); // drive animation
+}
+void Game::renderStart(const float alpha) {
+    static auto const& renderer{Renderer::get()};
+    renderer.clear();
+    hud->pressStartText.draw(alpha);
+    drawStatsOverlay();
+    renderer.show();
 }
 
-void Game::done() { scheduleTransition(currentState->onDone); }
-void Game::quit() { scheduleTransition(currentState->onQuit); }
-void Game::pause() { scheduleTransition(currentState->onPause); }
-void Game::next() { scheduleTransition(currentState->onNext); }
-void Game::confirm() { scheduleTransition(currentState->onConfirm); }
-void Game::cancel() { scheduleTransition(currentState->onCancel); }
-void Game::gameOver() { scheduleTransition(currentState->onGameOver); }
+// --- Reset
+void Game::enterReset() {
+    match.reset();
+    isMatchStarting = true;
+    next();
+}
 
-// -----------------------------------------------------------------------------
-// Rules Processing (Collision, Goals, Score, etc)
-// -----------------------------------------------------------------------------
+// --- Countdown
+void Game::enterCountdown() {
+    // The countdown is purely for the players' benefit.
+    if (isHeadless()) {
+        next();
+    }
+}
+void Game::simulateCountdown(const float delta) {
+    if (!isHeadless()) {
+        hud->countdown.update(delta);
+    }
+}
+void Game::renderCountdown(const float alpha) {
+    static const Renderer& renderer{Renderer::get()};
+    (void)alpha;
+
+    // Nothing moves during the countdown, draw at rest.
+    renderer.clear();
+    // Draw paddles for "visual effect"
+    match.getLeftPaddle().draw(1);
+    match.getRightPaddle().draw(1);
+    match.getLeftScore().draw(1);
+    match.getRightScore().draw(1);
+    hud->countdown.draw(1);
+    drawStatsOverlay();
+    renderer.show();
+}
 
-// TODO: Generalize Physics Processing
-// NOTE: Overturn decision 0008.
-void Game::resolveFrameCollisions() {
-    Paddle& lp{leftPaddle};
-    Paddle& rp{rightPaddle};
-    Ball& b{ball};
-    Rect& f{field};
-
-    // --- Left Paddle & Field
-    if (lp.getTopEdgePosition() < f.y) {
-        // Align to top of field
-        lp.setTopEdgePosition(f.y);
-    } else if (lp.getBottomEdgePosition() > f.y + f.h) {
-        // Align to bottom of field
-        lp.setBottomEdgePosition(f.y + f.h);
+// --- Field Setup
+void Game::enterFieldSetup() {
+    if (isMatchStarting) {
+        startMatch();
     }
+    match.serve();
+    next();
+}
 
-    // --- Right Paddle & Field
-    if (rp.getTopEdgePosition() < f.y) {
-        // Aligned to top of field
-        rp.setTopEdgePosition(f.y);
-    } else if (rp.getBottomEdgePosition() > f.y + f.h) {
-        // Align to bottom of field
-        rp.setBottomEdgePosition(f.y + f.h);
+// --- Playing
+void Game::simulatePlaying(const float delta) {
+    // Record exactly what the step will see.
+    if (isRecording()) {
+        replay.ticks.push_back(InputBus::get().getActionState().pressed);
     }
+    const Match::Phase phase{match.step(delta)};
 
-    // --- Ball & Field
-    if (b.getTopEdgePosition() < f.y) {
-        // Bounce
-        Vector2 v{b.getVelocity()};
-        b.setVelocity(v.x, std::abs(v.y));
-    } else if (b.getBottomEdgePosition() > f.y + f.h) {
-        // Bounde
-        Vector2 v{b.getVelocity()};
-        b.setVelocity(v.x, -std::abs(v.y));
-    } else if (b.getLeftEdgePosition() < f.x) {
-        // Delegate field-goal handler
-        handleLeftGoal();
-    } else if (b.getRightEdgePosition() > f.x + f.w) {
-        // Delegate field-goal handler
-        handleRightGoal();
+    switch (phase) {
+    case Match::Phase::point:
+        next();
+        break;
+    case Match::Phase::over:
+        gameOver();
+        break;
+    default:
+        break;
     }
+}
+void Game::renderPlaying(const float alpha) {
+    static const Renderer& render{Renderer::get()};
+
+    render.clear();
+
+    drawObstacles();
+    drawChaosBalls(alpha);
+    match.getBall().draw(alpha);
+    match.getLeftPaddle().draw(alpha);
+    match.getRightPaddle().draw(alpha);
+    match.getLeftScore().draw(alpha);
+    match.getRightScore().draw(alpha);
+    drawStatsOverlay();
+
+    render.show();
+}
+
+// --- Pause
+void Game::simulatePause(const float delta) {
+    hud->pauseText.update(delta); // drive animation
+}
+void Game::renderPause(const float alpha) {
+    static auto const& renderer{Renderer::get()};
+    // Paddles are frozen mid-motion, draw them where they stopped.
+    renderer.clear();
+    hud->pauseText.draw(alpha);
+    drawObstacles();
+    drawChaosBalls(1);
+    match.getLeftPaddle().draw(1);
+    match.getRightPaddle().draw(1);
+    match.getLeftScore().draw(1);
+    match.getRightScore().draw(1);
+    drawStatsOverlay();
+    renderer.show();
+}
 
-    // --- Ball & Left Paddle
-    if ((lp.getRect() - b.getRect()).hasPoint(0, 0)) {
-        // Bounce
-        Vector2 v{b.getVelocity()};
-        b.setVelocity(std::abs(v.x), v.y);
+// --- Game Over
+void Game::enterGameOver() {
+    if (isRecording()) {
+        replay.leftScore  = match.getLeftScore().getValue();
+        replay.rightScore = match.getRightScore().getValue();
+        replay.save(replayFile);
+    }
+    if (matchLimit && match.getStatistics().matches >= matchLimit) {
+        quit();
+    } else if (isHeadless()) {
+        // Nobody to press START when headless.
+        confirm();
+    }
+}
+void Game::simulateGameOver(const float delta) {
+    if (isHeadless()) {
+        return;
     }
+    hud->gameOverText.update(delta); // drive animation
+    hud->resetText.update(delta);
+}
+void Game::renderGameOver(const float alpha) {
+    static auto const& renderer{Renderer::get()};
+    renderer.clear();
+    hud->gameOverText.draw(alpha);
+    hud->resetText.draw(alpha);
+    drawStatsOverlay();
+    renderer.show();
+}
+
+// --- Shut Down
+void Game::enterShutdown() { stop(); }
 
-    // --- Ball & Right Paddle
-    if ((rp.getRect() - b.getRect()).hasPoint(0, 0)) {
-        // Bounce
-        Vector2 v{b.getVelocity()};
-        b.setVelocity(-std::abs(v.x), v.y);
+// -----------------------------------------------------------------------------
+// Trigger-to-State Dispatch
+// -----------------------------------------------------------------------------
+
+// TODO: Generalize Event Bus
+void Game::scheduleTransition(const Trigger trigger) {
+    // Resolved now, against the state the trigger was pulled in.
+    const State target{getTarget(currentState, trigger)};
+    // No transition for `trigger` from here; ignore it.
+    if (target != currentState) {
+        transitionQueue.push(
+            {target, isTracingTransitions ? SDL_GetPerformanceCounter() : 0});
     }
 }
 
-void Game::handleLeftGoal() {
-    leftScore.increment();
-    if (leftScore.isAtMax()) {
-        gameOver();
-    } else {
-        next();
+void Game::handleTransition(const PendingTransition& transition) {
+    const State previous{currentState};
+    // Call the exit handler of the old state, if the handler exists
+    if (const auto exit{getDescription(currentState).exit}) {
+        (this->*exit)();
+    }
+    // Transition to the target state provided by the caller
+    currentState = transition.target;
+    // Call the enter handler of the new state, if the handler exists
+    if (const auto enter{getDescription(currentState).enter}) {
+        (this->*enter)();
+    }
+
+    if (isTracingTransitions) {
+        const double milliseconds{
+            (SDL_GetPerformanceCounter() - transition.counter) * 1000.0 /
+            SDL_GetPerformanceFrequency()};
+        spdlog::debug("Transition: {} -> {} in {:.3f} ms", getDescription(previous).tag,
+                      getDescription(currentState).tag, milliseconds);
     }
 }
 
-void Game::handleRightGoal() {
-    rightScore.increment();
-    if (rightScore.isAtMax()) {
-        gameOver();
-    } else {
-        next();
+void Game::drainTransitions() {
+    PROFILE_ZONE("Game::drainTransitions");
+    // Pass-through states (reset, field setup) trigger their way out on
+    // enter; following them here means no tick is spent in them.
+    for (unsigned int count = 0; !transitionQueue.empty(); ++count) {
+        if (count == maxTransitionsPerTick) {
+            // Leave the rest for the next tick rather than spin forever.
+            spdlog::error("{} state transitions in one tick; is there a cycle? "
+                          "(Now in {} state.)",
+                          count, getDescription(currentState).tag);
+            return;
+        }
+        const PendingTransition transition{transitionQueue.front()};
+        transitionQueue.pop();
+        handleTransition(transition);
     }
 }
+
+void Game::done() { scheduleTransition(Trigger::done); }
+void Game::quit() { scheduleTransition(Trigger::quit); }
+void Game::pause() { scheduleTransition(Trigger::pause); }
+void Game::next() { scheduleTransition(Trigger::next); }
+void Game::confirm() { scheduleTransition(Trigger::confirm); }
+void Game::cancel() { scheduleTransition(Trigger::cancel); }
+void Game::gameOver() { scheduleTransition(Trigger::gameOver); }
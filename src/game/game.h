@@ -1,44 +1,203 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "core/app.h"
-#include "game/entities/ball.h"
+#include "game/entities/countdown.h"
 #include "game/entities/fading_text.h"
-#include "game/entities/paddle.h"
-#include "game/entities/score.h"
 #include "game/input_bus.h"
+#include "game/match.h"
+#include "game/pilot.h"
+#include "game/replay.h"
 
 /**
  * A fancy FSM to dispatch `App` control to `Game::State`s.
  *
+ * Which trigger leads where is one `constexpr` table (`transitions`), and
+ * what each state does is another (`stateDescriptions`), both checked at
+ * compile time: every state has a way out on quit, every state is reachable,
+ * and every state simulates and renders.
+ *
+ * The rules of play live in a `Match`; `Game` adds menus, pausing, the
+ * countdown, and presentation around it.
+ *
+ * In headless mode (`App::Config::headless`) nothing presentational is
+ * built: no font, no textures. Menus confirm themselves and the countdown is
+ * skipped, so with computer pilots matches play back-to-back until
+ * `Config::matchLimit` is reached.
+ *
  * TODO: Tests
  * TODO: Separation of States
  */
 class Game : public App {
-    struct State {
-        State(const std::string tag) : tag{tag} {};
-        const std::string tag;
-
-        std::function<void(const float)> processFrame;
-
-        std::function<void()> enter;
-        std::function<void()> exit;
-
-        // --- Event-Transition Mappings
-        // (These pointers do not "own" their targets)
-        State* onDone{nullptr};
-        State* onQuit{nullptr};
-        State* onPause{nullptr};
-        State* onNext{nullptr};
-        State* onConfirm{nullptr};
-        State* onCancel{nullptr};
-        State* onGameOver{nullptr};
+    // ---------------------------------
+    // States & Transitions
+    // ---------------------------------
+
+    enum class State : uint8_t {
+        start,
+        reset,
+        countdown,
+        fieldSetup,
+        playing,
+        pause,
+        gameOver,
+        shutdown,
+    };
+    static constexpr std::size_t stateCount{8};
+
+    enum class Trigger : uint8_t {
+        done,
+        quit,
+        pause,
+        next,
+        confirm,
+        cancel,
+        gameOver,
+    };
+    static constexpr std::size_t triggerCount{7};
+
+    struct Transition {
+        State from;
+        Trigger trigger;
+        State to;
+    };
+
+    /** Every transition. A trigger with none from the current state is ignored. */
+    static constexpr Transition transitions[]{
+        {State::start, Trigger::confirm, State::fieldSetup},
+        {State::start, Trigger::quit, State::shutdown},
+
+        {State::reset, Trigger::next, State::fieldSetup},
+        {State::reset, Trigger::quit, State::shutdown},
+
+        {State::fieldSetup, Trigger::next, State::countdown},
+        {State::fieldSetup, Trigger::quit, State::shutdown},
+
+        {State::countdown, Trigger::next, State::playing},
+        {State::countdown, Trigger::quit, State::shutdown},
+
+        {State::playing, Trigger::pause, State::pause},
+        {State::playing, Trigger::next, State::fieldSetup},
+        {State::playing, Trigger::gameOver, State::gameOver},
+        {State::playing, Trigger::quit, State::shutdown},
+
+        {State::pause, Trigger::pause, State::playing},
+        {State::pause, Trigger::quit, State::shutdown},
+
+        {State::gameOver, Trigger::confirm, State::reset},
+        {State::gameOver, Trigger::cancel, State::shutdown},
+        {State::gameOver, Trigger::quit, State::shutdown},
+    };
+
+    /**
+     * `transitionTable[from][trigger]`: the target, or `from` itself where
+     * there is no transition. Built from `transitions`; a duplicate
+     * (from, trigger) pair fails to compile.
+     */
+    using TransitionTable = std::array<std::array<State, triggerCount>, stateCount>;
+    static constexpr TransitionTable transitionTable{[]() {
+        TransitionTable table{};
+        std::array<std::array<bool, triggerCount>, stateCount> isSet{};
+        for (std::size_t from = 0; from < stateCount; ++from) {
+            table[from].fill(static_cast<State>(from));
+        }
+        for (const Transition& transition : transitions) {
+            const auto from{static_cast<std::size_t>(transition.from)};
+            const auto trigger{static_cast<std::size_t>(transition.trigger)};
+            if (isSet[from][trigger]) {
+                throw "Duplicate transition";
+            }
+            isSet[from][trigger] = true;
+            table[from][trigger] = transition.to;
+        }
+        return table;
+    }()};
+
+    static constexpr State getTarget(State from, Trigger trigger) {
+        return transitionTable[static_cast<std::size_t>(from)]
+                              [static_cast<std::size_t>(trigger)];
+    }
+
+    static constexpr bool canQuitFromEveryState() {
+        for (std::size_t from = 0; from < stateCount; ++from) {
+            const State state{static_cast<State>(from)};
+            if (state != State::shutdown && getTarget(state, Trigger::quit) == state) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr bool isEveryStateReachable() {
+        std::array<bool, stateCount> isReached{};
+        isReached[static_cast<std::size_t>(State::start)] = true;
+        // Relax until nothing changes; at most one pass per state.
+        for (std::size_t pass = 0; pass < stateCount; ++pass) {
+            for (const Transition& transition : transitions) {
+                if (isReached[static_cast<std::size_t>(transition.from)]) {
+                    isReached[static_cast<std::size_t>(transition.to)] = true;
+                }
+            }
+        }
+        for (bool reached : isReached) {
+            if (!reached) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * What a state does. `simulate` and `render` are required, `enter` and
+     * `exit` optional (null).
+     */
+    struct StateDescription {
+        const char* tag;
+        void (Game::*simulate)(float delta);
+        void (Game::*render)(float alpha);
+        void (Game::*enter)();
+        void (Game::*exit)();
     };
 
+    /**
+     * Indexed by `State`. Defined in game.cpp, where it (and the checks on
+     * `transitions`) are asserted once the class is complete.
+     */
+    static const StateDescription stateDescriptions[stateCount];
+
   public:
-    Game(const App::Config& config);
+    struct Config {
+        App::Config app;
+        Pilot leftPilot;
+        Pilot rightPilot;
+        /** Stop after this many completed matches. Zero means never. */
+        uint64_t matchLimit{0};
+        /** See `Match::Config::chaosBalls`. */
+        uint32_t chaosBalls{0};
+        /** See `Match::Config::chaosCollisions`. */
+        bool chaosCollisions{false};
+        /** See `Match::Config::obstacles`. */
+        std::vector<Rect> obstacles{};
+        /**
+         * Record every match (see `Replay`) and save it here when it ends,
+         * overwriting the last. Empty means don't record.
+         */
+        std::string replayFile{};
+        /**
+         * Log every state transition, with how long it took from trigger
+         * to the target's `enter` returning.
+         */
+        bool traceTransitions{false};
+    };
+
+    Game(const Config& config);
     ~Game() override;
 
     Game(Game& game)              = delete;
@@ -46,49 +205,104 @@ class Game : public App {
     Game& operator=(const Game&)  = delete;
     Game& operator=(const Game&&) = delete;
 
-    void processFrame(const float delta) override;
+    void simulate(const float delta) override;
+    void render(const float alpha) override;
     void processEvent(const SDL_Event& event) override;
 
+    const Match::Statistics& getStatistics() const;
+
   private:
+    /**
+     * Presentation-only members. Not built in headless mode.
+     */
+    struct Hud {
+        Hud(const Rect& field, Countdown::CallbackType onCountdownDone);
+        Font font;
+        GlyphAtlas atlas;
+        FadingText pressStartText;
+        FadingText pauseText;
+        FadingText gameOverText;
+        FadingText resetText;
+        Countdown countdown;
+    };
+
     // --- Data Members
-    std::queue<State*> transitionQueue;
+    struct PendingTransition {
+        State target;
+        /** Performance counter at the trigger; only read when tracing. */
+        uint64_t counter;
+    };
+    std::queue<PendingTransition> transitionQueue;
+    /**
+     * Most transitions handled in one tick. Chains (reset, field setup,
+     * countdown, playing) are a handful long; more means a cycle.
+     */
+    static const unsigned int maxTransitionsPerTick{16};
     Rect field;
-    Paddle leftPaddle;
-    Paddle rightPaddle;
-    Ball ball;
-    State* currentState;
-    Font font;
-    Score leftScore;
-    Score rightScore;
+    State currentState{State::start};
+    std::unique_ptr<Hud> hud;
+    Match::Config matchConfig;
+    Match match;
+    uint64_t matchLimit;
+
+    // --- Recording
+    /** See `Config::replayFile`. */
+    std::string replayFile;
+    unsigned int tickRate;
+    /** The match in progress, when recording. */
+    Replay replay;
+    /** Has the match about to be served not started yet? */
+    bool isMatchStarting{true};
+
+    /** Show `FrameStats` over whatever is drawn. */
+    bool isStatsOverlayVisible{false};
+    /** See `Config::traceTransitions`. */
+    bool isTracingTransitions;
+
+    bool isHeadless() const;
+    void drawChaosBalls(float alpha) const;
+    void drawObstacles() const;
+    void drawStatsOverlay() const;
+    void startMatch();
+    bool isRecording() const;
 
     // --- Static Members
     static const Score::ValueType maxScore{6};
 
-    // --- Rules (Collision, Goal, Score, etc.)
-    void handleLeftGoal();
-    void handleRightGoal();
-    void resolveFrameCollisions();
-
     // --- Input
     // Various input-action event subscriptions
     InputBus::Subscription actionSubscription;
 
     // --- State Management
-    // States
-    State startState{"Start"};
-    State resetState{"Reset"};
-    State countdownState{"Countdown"};
-    State fieldSetupState{"Field Setup"};
-    State playingState{"Playing"};
-    State pauseState{"Pause"};
-    State gameOverState{"Game Over"};
-    State shutdownState{"Shutdown"};
+    // Behavior (see `stateDescriptions`)
+    void simulateStart(float delta);
+    void renderStart(float alpha);
+    void enterReset();
+    void enterCountdown();
+    void simulateCountdown(float delta);
+    void renderCountdown(float alpha);
+    void enterFieldSetup();
+    void simulatePlaying(float delta);
+    void renderPlaying(float alpha);
+    void simulatePause(float delta);
+    void renderPause(float alpha);
+    void enterGameOver();
+    void simulateGameOver(float delta);
+    void renderGameOver(float alpha);
+    void enterShutdown();
+    /** For states that pass straight through. */
+    void simulateNothing(float delta);
+    void renderNothing(float alpha);
+
+    const StateDescription& getDescription(State state) const;
 
     // Triggers
     // "Raw" transition handler
-    void handleTransition(State* target);
+    void handleTransition(const PendingTransition& transition);
+    /** Handle queued transitions, and any they queue, before this tick. */
+    void drainTransitions();
     // "Dispatch" transition handler
-    void scheduleTransition(State* target);
+    void scheduleTransition(Trigger trigger);
     // Specific transition dispatch
     void done();
     void quit();
@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
 
 #include <spdlog/spdlog.h>
 
@@ -21,20 +24,26 @@ InputBus::~InputBus() {}
 void InputBus::initialize(const Config& config) {
     spdlog::info("Initializing {}.", TAG);
 
-    for (auto const& [action, description] : config.actionMap) {
-        // Store the action's input type for later reference.
-        actionToInputTypeMap[action] = description.type;
-
-        // Assign action to appropriate input-type-to-action map.
-        switch (description.type) {
+    // Assign each binding to the appropriate input-to-action map.
+    for (const Config::Binding& binding : config.bindings) {
+        const std::size_t player{static_cast<std::size_t>(binding.player)};
+        switch (binding.type) {
         case InputType::keyboard:
-            actionToScancodeMap[action] = description.keyboard.scancode;
-            scancodeToActionMap[description.keyboard.scancode] = action;
+            scancodeToActionMap[binding.input] = binding.action;
             break;
 
         case InputType::mouse:
-            actionToMouseButtonMap[action]              = description.mouse.button;
-            buttonToActionMap[description.mouse.button] = action;
+            buttonToActionMap[binding.input] = binding.action;
+            break;
+
+        case InputType::controllerButton:
+            controllerButtonToActionMap[player][binding.input] = binding.action;
+            break;
+
+        case InputType::controllerAxis:
+            controllerAxisToActionMap[player][binding.input]
+                                     [binding.direction == AxisDirection::positive] =
+                                         binding.action;
             break;
 
         default:
@@ -42,15 +51,46 @@ void InputBus::initialize(const Config& config) {
             break;
         }
     }
+
+    // Keep just what ended up bound, for polling.
+    for (int scancode = 0; scancode < SDL_NUM_SCANCODES; ++scancode) {
+        if (scancodeToActionMap[scancode] != Action::none) {
+            boundKeys.push_back({scancode, scancodeToActionMap[scancode]});
+        }
+    }
+    for (int button = 0; button < mouseButtonCount; ++button) {
+        if (buttonToActionMap[button] != Action::none) {
+            boundMouseButtons.push_back({button, buttonToActionMap[button]});
+        }
+    }
+
+    const float deadZone{std::clamp(config.controllerDeadZone, 0.0f, 0.99f)};
+    axisThreshold = static_cast<int16_t>(std::lround(deadZone * 32767) + 1);
+
+    // Controllers already connected before this point announced themselves
+    // to whoever was listening then; pick them up now.
+    for (int device = 0; device < SDL_NumJoysticks(); ++device) {
+        openController(device);
+    }
 }
 
 void InputBus::terminate() {
     spdlog::info("Terminating {}.", TAG);
-    actionToInputTypeMap.clear();
-    actionToScancodeMap.clear();
-    actionToMouseButtonMap.clear();
     std::fill_n(scancodeToActionMap, SDL_NUM_SCANCODES, Action::none);
     std::fill_n(buttonToActionMap, mouseButtonCount, Action::none);
+    std::fill_n(&controllerButtonToActionMap[0][0], playerCount * controllerButtonCount,
+                Action::none);
+    std::fill_n(&controllerAxisToActionMap[0][0][0],
+                playerCount * controllerAxisCount * 2, Action::none);
+    boundKeys.clear();
+    boundMouseButtons.clear();
+
+    for (Controller& controller : controllers) {
+        if (controller.controller) {
+            SDL_GameControllerClose(controller.controller);
+        }
+        controller = Controller{};
+    }
 }
 
 void InputBus::reinitialize(const Config& config) {
@@ -81,9 +121,7 @@ void InputBus::handleKeyDownEvent(const SDL_KeyboardEvent& event) const {
         return;
     }
 
-    for (auto const& observer : observers) {
-        observer(action);
-    }
+    pressAction(action);
 }
 
 void InputBus::handleMouseButtonDownEvent(const SDL_MouseButtonEvent& event) const {
@@ -95,36 +133,307 @@ void InputBus::handleMouseButtonDownEvent(const SDL_MouseButtonEvent& event) con
         return;
     }
 
-    for (auto const& observer : observers) {
-        observer(action);
+    pressAction(action);
+}
+
+void InputBus::handleControllerEvent(const SDL_Event& event) {
+    switch (event.type) {
+    case SDL_CONTROLLERDEVICEADDED:
+        openController(event.cdevice.which);
+        return;
+
+    case SDL_CONTROLLERDEVICEREMOVED:
+        if (Controller* controller{findController(event.cdevice.which)}) {
+            spdlog::info("{}: Player {} controller disconnected.", TAG,
+                         controller - controllers + 1);
+            SDL_GameControllerClose(controller->controller);
+            *controller = Controller{};
+        }
+        return;
+
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+    case SDL_CONTROLLERAXISMOTION:
+        break;
+
+    default:
+        return;
+    }
+
+    // Events from controllers we didn't open (no free player) are ignored.
+    const bool isAxis{event.type == SDL_CONTROLLERAXISMOTION};
+    Controller* controller{
+        findController(isAxis ? event.caxis.which : event.cbutton.which)};
+    if (!controller) {
+        return;
+    }
+    const std::size_t player{static_cast<std::size_t>(controller - controllers)};
+
+    switch (event.type) {
+    case SDL_CONTROLLERBUTTONDOWN:
+        if (event.cbutton.button < controllerButtonCount) {
+            controller->buttons |= uint32_t{1} << event.cbutton.button;
+            const Action action{
+                controllerButtonToActionMap[player][event.cbutton.button]};
+            if (action != Action::none) {
+                pressAction(action);
+            }
+        }
+        break;
+
+    case SDL_CONTROLLERBUTTONUP:
+        if (event.cbutton.button < controllerButtonCount) {
+            controller->buttons &= ~(uint32_t{1} << event.cbutton.button);
+        }
+        break;
+
+    case SDL_CONTROLLERAXISMOTION:
+        if (event.caxis.axis < controllerAxisCount) {
+            handleControllerAxis(*controller, player, event.caxis.axis,
+                                 event.caxis.value);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void InputBus::handleControllerAxis(Controller& controller, std::size_t player,
+                                    uint8_t axis, int16_t value) {
+    const int8_t direction{static_cast<int8_t>(value >= axisThreshold    ? 1
+                                               : value <= -axisThreshold ? -1
+                                                                         : 0)};
+    if (direction == controller.axes[axis]) {
+        return;
+    }
+    controller.axes[axis] = direction;
+
+    // Pushing past the dead zone is a press, like a button's.
+    if (direction) {
+        const Action action{controllerAxisToActionMap[player][axis][direction > 0]};
+        if (action != Action::none) {
+            pressAction(action);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Controllers
+// -----------------------------------------------------------------------------
+
+void InputBus::openController(int device) {
+    if (!SDL_IsGameController(device)) {
+        return;
+    }
+    const SDL_JoystickID id{SDL_JoystickGetDeviceInstanceID(device)};
+    if (findController(id)) {
+        return;
+    }
+
+    Controller* slot{std::find_if(std::begin(controllers), std::end(controllers),
+                                  [](const Controller& controller) {
+                                      return !controller.controller;
+                                  })};
+    if (slot == std::end(controllers)) {
+        spdlog::info("{}: Every player has a controller; ignoring another.", TAG);
+        return;
+    }
+
+    SDL_GameController* opened{SDL_GameControllerOpen(device)};
+    if (!opened) {
+        spdlog::warn("{}: Could not open controller: {}", TAG, SDL_GetError());
+        return;
+    }
+    *slot = Controller{.controller = opened, .id = id};
+    spdlog::info("{}: Player {} controller connected.", TAG, slot - controllers + 1);
+}
+
+InputBus::Controller* InputBus::findController(SDL_JoystickID id) {
+    for (Controller& controller : controllers) {
+        if (controller.controller && controller.id == id) {
+            return &controller;
+        }
     }
+    return nullptr;
+}
+
+void InputBus::pressAction(Action action) const {
+    pressedSinceUpdate |= getActionBit(action);
+    dispatchActionPressed(action);
 }
 
 // -----------------------------------------------------------------------------
 // Action-Event Subscriptions
 // -----------------------------------------------------------------------------
 
-InputBus::Subscription
-InputBus::onActionPressed(std::function<void(Action action)> callback) {
-    return observers.insert(observers.end(), callback);
+InputBus::Subscription InputBus::onActionPressed(Observer observer) {
+    assert(!isDispatching && "Subscribed from inside an observer");
+
+    uint32_t handle;
+    if (freeHandles.empty()) {
+        handle = static_cast<uint32_t>(handles.size());
+        handles.emplace_back();
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+
+    handles[handle].observer = static_cast<uint32_t>(observers.size());
+    observers.push_back(std::move(observer));
+    observerHandles.push_back(handle);
+    return Subscription{handle, handles[handle].generation};
 }
 
-void InputBus::offActionPressed(Subscription subscription) {
-    observers.erase(subscription);
+void InputBus::offActionPressed(Subscription& subscription) { subscription.reset(); }
+
+void InputBus::unsubscribe(uint32_t handle, uint32_t generation) {
+    assert(!isDispatching && "Unsubscribed from inside an observer");
+    if (handle >= handles.size() || handles[handle].generation != generation) {
+        return;
+    }
+
+    // Swap-and-pop keeps the observers packed.
+    const uint32_t index{handles[handle].observer};
+    const uint32_t last{static_cast<uint32_t>(observers.size() - 1)};
+    if (index != last) {
+        observers[index]                         = std::move(observers[last]);
+        observerHandles[index]                   = observerHandles[last];
+        handles[observerHandles[index]].observer = index;
+    }
+    observers.pop_back();
+    observerHandles.pop_back();
+
+    ++handles[handle].generation;
+    freeHandles.push_back(handle);
+}
+
+void InputBus::dispatchActionPressed(Action action) const {
+    isDispatching = true;
+    for (const Observer& observer : observers) {
+        observer(action);
+    }
+    isDispatching = false;
 }
 
+// -----------------------------------------------------------------------------
+// Subscription
+// -----------------------------------------------------------------------------
+
+InputBus::Subscription::Subscription(uint32_t handle, uint32_t generation)
+    : handle{handle}, generation{generation} {}
+
+InputBus::Subscription::~Subscription() { reset(); }
+
+InputBus::Subscription::Subscription(Subscription&& other) noexcept
+    : handle{other.handle}, generation{other.generation} {
+    other.generation = 0;
+}
+
+InputBus::Subscription&
+InputBus::Subscription::operator=(Subscription&& other) noexcept {
+    if (this != &other) {
+        reset();
+        handle           = other.handle;
+        generation       = other.generation;
+        other.generation = 0;
+    }
+    return *this;
+}
+
+void InputBus::Subscription::reset() {
+    if (generation) {
+        InputBus::get().unsubscribe(handle, generation);
+        generation = 0;
+    }
+}
+
+bool InputBus::Subscription::isSubscribed() const { return generation != 0; }
+
+// -----------------------------------------------------------------------------
+// Per-Tick Action State
+// -----------------------------------------------------------------------------
+
+InputBus::ActionSet InputBus::getActionBit(Action action) {
+    return ActionSet{1} << static_cast<unsigned>(action);
+}
+
+bool InputBus::ActionState::isPressed(Action action) const {
+    return pressed & getActionBit(action);
+}
+
+bool InputBus::ActionState::isJustPressed(Action action) const {
+    return justPressed & getActionBit(action);
+}
+
+bool InputBus::ActionState::isJustReleased(Action action) const {
+    return justReleased & getActionBit(action);
+}
+
+InputBus::ActionState InputBus::ActionState::next(ActionSet held) const {
+    return ActionState{
+        .pressed      = held,
+        .justPressed  = held & ~pressed,
+        .justReleased = pressed & ~held,
+    };
+}
+
+const InputBus::ActionState& InputBus::updateActionState() {
+    const ActionSet held{getLiveActions() | pressedSinceUpdate};
+    pressedSinceUpdate = 0;
+    return setActionState(held);
+}
+
+const InputBus::ActionState& InputBus::setActionState(ActionSet held) {
+    actionState = actionState.next(held);
+    return actionState;
+}
+
+const InputBus::ActionState& InputBus::getActionState() const { return actionState; }
+
 // -----------------------------------------------------------------------------
 // Config :: Input Action Configuration
 // -----------------------------------------------------------------------------
 
 void InputBus::Config::setKeyboardKeyDownAction(SDL_Scancode scancode, Action action) {
-    actionMap[action].type              = InputType::keyboard;
-    actionMap[action].keyboard.scancode = scancode;
+    if (scancode >= 0 && scancode < SDL_NUM_SCANCODES) {
+        bindings.push_back(
+            {.type = InputType::keyboard, .input = scancode, .action = action});
+    }
 }
 
 void InputBus::Config::setMouseButtonDownAction(uint8_t button, Action action) {
-    actionMap[action].type         = InputType::mouse;
-    actionMap[action].mouse.button = button;
+    if (button < mouseButtonCount) {
+        bindings.push_back(
+            {.type = InputType::mouse, .input = button, .action = action});
+    }
+}
+
+void InputBus::Config::setControllerButtonDownAction(Player player,
+                                                     SDL_GameControllerButton button,
+                                                     Action action) {
+    if (button >= 0 && button < SDL_CONTROLLER_BUTTON_MAX) {
+        bindings.push_back({
+            .type   = InputType::controllerButton,
+            .player = player,
+            .input  = button,
+            .action = action,
+        });
+    }
+}
+
+void InputBus::Config::setControllerAxisAction(Player player,
+                                               SDL_GameControllerAxis axis,
+                                               AxisDirection direction, Action action) {
+    if (axis >= 0 && axis < SDL_CONTROLLER_AXIS_MAX) {
+        bindings.push_back({
+            .type      = InputType::controllerAxis,
+            .player    = player,
+            .input     = axis,
+            .direction = direction,
+            .action    = action,
+        });
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -132,24 +441,38 @@ void InputBus::Config::setMouseButtonDownAction(uint8_t button, Action action) {
 // -----------------------------------------------------------------------------
 
 bool InputBus::isActionPressed(Action action) const {
-    switch (actionToInputTypeMap.at(action)) {
-    case InputType::keyboard:
-        return isKeyboardKeyDownActionPressed(action);
-    case InputType::mouse:
-        return isMouseButtonDownActionPressed(action);
-    default:
-        return false;
-    }
+    return actionState.isPressed(action);
 }
 
-bool InputBus::isKeyboardKeyDownActionPressed(Action action) const {
-    SDL_Scancode scancode{actionToScancodeMap.at(action)};
+InputBus::ActionSet InputBus::getLiveActions() const {
+    ActionSet actions{0};
+
     const uint8_t* keyboardState = SDL_GetKeyboardState(NULL);
-    return keyboardState[scancode];
-}
+    for (const Bound& key : boundKeys) {
+        actions |= ActionSet{keyboardState[key.input] != 0}
+                   << static_cast<unsigned>(key.action);
+    }
 
-bool InputBus::isMouseButtonDownActionPressed(Action action) const {
-    uint8_t button{actionToMouseButtonMap.at(action)};
     const uint32_t mouseState = SDL_GetMouseState(NULL, NULL);
-    return SDL_BUTTON(button) & mouseState;
+    for (const Bound& button : boundMouseButtons) {
+        actions |= ActionSet{(SDL_BUTTON(button.input) & mouseState) != 0}
+                   << static_cast<unsigned>(button.action);
+    }
+
+    // Only held buttons and pushed axes are visited. Unbound ones map to
+    // `Action::none`, whose bit is dropped at the end.
+    for (std::size_t player = 0; player < playerCount; ++player) {
+        const Controller& controller{controllers[player]};
+        for (uint32_t held = controller.buttons; held; held &= held - 1) {
+            actions |= getActionBit(
+                controllerButtonToActionMap[player][std::countr_zero(held)]);
+        }
+        for (std::size_t axis = 0; axis < controllerAxisCount; ++axis) {
+            if (const int8_t direction{controller.axes[axis]}) {
+                actions |= getActionBit(
+                    controllerAxisToActionMap[player][axis][direction > 0]);
+            }
+        }
+    }
+    return actions & ~getActionBit(Action::none);
 }
@@ -1,13 +1,16 @@
 #pragma once
 
-#include <functional>
-#include <list>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include <SDL_events.h>
+#include <SDL_gamecontroller.h>
 #include <SDL_scancode.h>
 
+#include "core/inplace_function.h"
+#include "game/player.h"
+
 // TODO: Separate input bus from game-specific actions
 // NOTE: Consider pub-sub with message broker (event channel)
 // TODO: Tests
@@ -24,6 +27,16 @@ class InputBus {
         none,
         keyboard,
         mouse,
+        controllerButton,
+        controllerAxis,
+    };
+
+    /**
+     * Which way a controller axis must be pushed, past the dead zone.
+     */
+    enum class AxisDirection {
+        negative,
+        positive,
     };
 
     /**
@@ -38,29 +51,101 @@ class InputBus {
         confirm,
         cancel,
         pause,
-        quit
+        quit,
+        toggleStats
+    };
+
+    /**
+     * A set of actions, one bit per `Action` (bit `n` for value `n`).
+     */
+    using ActionSet = uint32_t;
+
+    static ActionSet getActionBit(Action action);
+
+    /**
+     * Every action's state for one simulation tick: held, and whether that
+     * changed since the tick before. Queries are single bit tests.
+     *
+     * A tick's state follows from its `pressed` set and the previous tick's
+     * (see `next`), so a sequence of `ActionSet`s is all that replays (and
+     * anything else replicating input) need to carry.
+     */
+    struct ActionState {
+        ActionSet pressed{0};
+        /** Pressed this tick, but not the last. */
+        ActionSet justPressed{0};
+        /** Pressed the last tick, but not this one. */
+        ActionSet justReleased{0};
+
+        bool isPressed(Action action) const;
+        bool isJustPressed(Action action) const;
+        bool isJustReleased(Action action) const;
+
+        /** The state of a tick holding `held` that follows this one. */
+        ActionState next(ActionSet held) const;
     };
 
     // ---------------------------------
     // Subscription Node
     // ---------------------------------
 
-    // TODO: Wrap iterator in RAII to auto-unsubscribe on out-of-scope,
-    //       or use custom delete over std::unique_ptr template.
-    typedef std::_List_iterator<std::function<void(InputBus::Action)>> Subscription;
+    /**
+     * Action-pressed callback. Stored inline; never allocates.
+     */
+    using Observer = InplaceFunction<void(Action)>;
+
+    /**
+     * Handle to an `onActionPressed` observer. Unsubscribes when destroyed
+     * (or `reset`), so it must not outlive the `InputBus` singleton.
+     *
+     * Handles are an index into the bus's handle table plus the generation
+     * of the slot they were issued for, so a stale handle (whose slot has
+     * since been reused) does nothing.
+     */
+    class Subscription {
+      public:
+        Subscription() = default;
+        ~Subscription();
+
+        Subscription(Subscription&& other) noexcept;
+        Subscription& operator=(Subscription&& other) noexcept;
+        Subscription(const Subscription&)            = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        /** Unsubscribe now. Does nothing if not subscribed. */
+        void reset();
+
+        bool isSubscribed() const;
+
+      private:
+        friend InputBus;
+        /** Unit tests forge stale handles (tests/input_bus.subscriptions.cpp). */
+        friend struct InputBusTests;
+        Subscription(uint32_t handle, uint32_t generation);
+
+        uint32_t handle{0};
+        /** Zero for no subscription; live slots start at one. */
+        uint32_t generation{0};
+    };
 
     // ---------------------------------
     // Configuration
     // ---------------------------------
 
-    // TODO: Separate action map by player.
-
+    /**
+     * Input-to-action bindings.
+     *
+     * Any number of inputs may trigger the same action (say, a key, a
+     * D-pad button, and a stick); each input triggers at most one action,
+     * and binding it again replaces the earlier binding.
+     *
+     * Controllers bind per player: the first controller connected plays
+     * `Player::one`, the next `Player::two`. A controller that disconnects
+     * frees its player for the next one to connect.
+     */
     struct Config {
         friend InputBus;
 
-        // It is undefined behavior to assign multiple inputs to the same action.
-        // TODO: Consider supporting multiple inputs / input-types per action.
-
         /**
          * Relate a keyboard key scancode to an action.
          *
@@ -75,29 +160,36 @@ class InputBus {
          */
         void setMouseButtonDownAction(uint8_t button, Action action);
 
-      private:
-        struct KeyboardKeyActionDescription {
-            KeyboardKeyActionDescription(){}; // by default do nothing interesting.
-            KeyboardKeyActionDescription(SDL_Scancode scancode);
-            InputType type;
-            SDL_Scancode scancode;
-        };
+        /**
+         * Relate a button on `player`'s controller to an action.
+         */
+        void setControllerButtonDownAction(Player player,
+                                           SDL_GameControllerButton button,
+                                           Action action);
 
-        struct MouseButtonActionDescription {
-            MouseButtonActionDescription(){}; // by default do nothing interesting.
-            MouseButtonActionDescription(uint8_t button);
-            InputType type;
-            uint8_t button;
-        };
+        /**
+         * Relate pushing an axis of `player`'s controller in `direction`
+         * (further than `controllerDeadZone`) to an action.
+         */
+        void setControllerAxisAction(Player player, SDL_GameControllerAxis axis,
+                                     AxisDirection direction, Action action);
+
+        /**
+         * Fraction of an axis' travel, in [0, 1), that counts as centered.
+         */
+        float controllerDeadZone{0.25f};
 
-        union ActionDescription {
-            ActionDescription(){};
-            InputType type;
-            KeyboardKeyActionDescription keyboard;
-            MouseButtonActionDescription mouse;
+      private:
+        struct Binding {
+            InputType type{InputType::none};
+            Player player{Player::one};
+            /** Scancode, mouse button, controller button, or axis. */
+            int input{0};
+            AxisDirection direction{AxisDirection::negative};
+            Action action{Action::none};
         };
 
-        std::unordered_map<Action, ActionDescription> actionMap;
+        std::vector<Binding> bindings;
     };
 
     ~InputBus();
@@ -111,34 +203,65 @@ class InputBus {
     void handleKeyDownEvent(const SDL_KeyboardEvent& event) const;
     void handleMouseButtonDownEvent(const SDL_MouseButtonEvent& event) const;
 
+    /**
+     * Controller connection, button, and axis events. Controllers are
+     * opened and assigned a player as they connect.
+     */
+    void handleControllerEvent(const SDL_Event& event);
+
+    /**
+     * Is `action` held this tick? Same as `getActionState().isPressed()`.
+     */
     bool isActionPressed(Action action) const;
-    Subscription onActionPressed(std::function<void(Action action)> callback);
-    void offActionPressed(Subscription subscription);
+
+    /**
+     * Call `observer` with every action pressed, until the returned
+     * subscription goes away. Observers must not subscribe or unsubscribe
+     * while being called.
+     */
+    [[nodiscard]] Subscription onActionPressed(Observer observer);
+    void offActionPressed(Subscription& subscription);
+
+    // --- Per-Tick Action State
+
+    /**
+     * Start a tick from live input: actions held right now, plus any
+     * pressed since the last update (even if already released), so that
+     * taps shorter than a tick aren't lost. Call once per simulation tick.
+     */
+    const ActionState& updateActionState();
+
+    /**
+     * Start a tick holding exactly `held` instead of live input, e.g. from
+     * a replay.
+     */
+    const ActionState& setActionState(ActionSet held);
+
+    /** This tick's state, as of the last update or set. */
+    const ActionState& getActionState() const;
 
     SDL_Event x;
 
   private:
     // --- Utility Action Queires
 
-    bool isKeyboardKeyDownActionPressed(Action action) const;
-    bool isMouseButtonDownActionPressed(Action action) const;
+    /** Actions held on any bound input right now. */
+    ActionSet getLiveActions() const;
 
-    // --- Action Maps
+    // --- Per-Tick Action State
 
-    /**
-     * Relate actions to their input type.
-     */
-    std::unordered_map<Action, InputType> actionToInputTypeMap;
+    ActionState actionState;
+    /** Actions pressed since the last `updateActionState`. */
+    mutable ActionSet pressedSinceUpdate{0};
 
-    /**
-     * Relates actions to scancodes.
-     */
-    std::unordered_map<Action, SDL_Scancode> actionToScancodeMap;
+    // --- Action Maps
+    // All lookups are by input, into flat arrays; `Action::none` means
+    // unbound. The binding lists hold only what is bound, so polling walks
+    // a handful of entries instead of every key.
 
-    /**
-     * Relates actions to mouse buttons.
-     */
-    std::unordered_map<Action, uint8_t> actionToMouseButtonMap;
+    static const std::size_t playerCount{2};
+    static const std::size_t controllerButtonCount{SDL_CONTROLLER_BUTTON_MAX};
+    static const std::size_t controllerAxisCount{SDL_CONTROLLER_AXIS_MAX};
 
     /**
      * Relates scancodes to actions.
@@ -157,9 +280,66 @@ class InputBus {
     static const uint8_t mouseButtonCount{6};
     Action buttonToActionMap[mouseButtonCount]; // Read note above on magic number `6`
 
+    /** Relates each player's controller buttons to actions. */
+    Action controllerButtonToActionMap[playerCount][controllerButtonCount];
+    /** Relates each player's controller axes, by direction, to actions. */
+    Action controllerAxisToActionMap[playerCount][controllerAxisCount][2];
+
+    /** Bound inputs, one entry per binding, for polling. */
+    struct Bound {
+        int input;
+        Action action;
+    };
+    std::vector<Bound> boundKeys;
+    std::vector<Bound> boundMouseButtons;
+
+    /** Axis position (in raw SDL units) past which it isn't centered. */
+    int16_t axisThreshold{0};
+
+    // --- Controllers
+    // Button and axis state is kept from events rather than queried, so it
+    // is exactly what the dispatched events said.
+
+    struct Controller {
+        SDL_GameController* controller{nullptr};
+        SDL_JoystickID id{-1};
+        /** Bit per `SDL_GameControllerButton`. */
+        uint32_t buttons{0};
+        /** Per axis: -1, 0, or 1 for pushed negative, centered, positive. */
+        int8_t axes[controllerAxisCount]{};
+    };
+    Controller controllers[playerCount];
+
+    void openController(int device);
+    Controller* findController(SDL_JoystickID id);
+    void handleControllerAxis(Controller& controller, std::size_t player,
+                              uint8_t axis, int16_t value);
+    void pressAction(Action action) const;
+
     // --- Observers
+    // Observers are packed densely, in no particular order, so dispatch is a
+    // linear walk over one array. `handles` is the indirection that lets
+    // subscriptions stay valid while observers move around.
+
+    struct Handle {
+        /** Bumped on every unsubscription, invalidating old handles. */
+        uint32_t generation{1};
+        /** Index into `observers` while subscribed. */
+        uint32_t observer{0};
+    };
+
+    std::vector<Observer> observers;
+    /** `observers[i]` was subscribed through `handles[observerHandles[i]]`. */
+    std::vector<uint32_t> observerHandles;
+    std::vector<Handle> handles;
+    std::vector<uint32_t> freeHandles;
+    /** Guards against observers changing the table under dispatch. */
+    mutable bool isDispatching{false};
+
+    void dispatchActionPressed(Action action) const;
+    void unsubscribe(uint32_t handle, uint32_t generation);
 
-    std::list<std::function<void(Action action)>> observers;
+    friend struct InputBusTests;
 
     // --- Explicitely deleted constructors
 
@@ -0,0 +1,503 @@
+#include <algorithm>
+#include <cmath>
+
+#include "core/profiler.h"
+#include "game/input_bus.h"
+
+#include "match.h"
+
+// -----------------------------------------------------------------------------
+// Static Function Components
+// -----------------------------------------------------------------------------
+
+/** Chaos ball speed, in pixels per second. */
+static const float chaosSpeed{300};
+
+/** Most impacts the ball resolves in a single tick before giving up. */
+static const int maxImpactsPerTick{4};
+
+/** Chaos ball edge length, in pixels. */
+static const float chaosSize{4};
+
+static int getInputDifference(InputBus::Action a, InputBus::Action b) {
+    static auto const& input{InputBus::get()};
+    return input.isActionPressed(b) - input.isActionPressed(a);
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+
+Match::Match(const Config& config)
+    : field{config.field}, leftPaddle{Player::one}, rightPaddle{Player::two},
+      ball{}, leftScore{{.atlas = config.atlas, .max = config.maxScore}},
+      rightScore{{.atlas = config.atlas, .max = config.maxScore}},
+      chaosBallCount{config.chaosBalls}, obstacles{config.obstacles},
+      chaosCollisions{config.chaosCollisions}, leftPilot{config.leftPilot},
+      rightPilot{config.rightPilot}, maxRallyTicks{config.maxRallyTicks},
+      random{config.seed},
+      world{{.field = field, .cellSize = static_cast<int>(2 * chaosSize)}} {
+    layOut();
+}
+
+// -----------------------------------------------------------------------------
+// Rules State Machine
+// -----------------------------------------------------------------------------
+
+void Match::reset() {
+    leftScore.reset();
+    rightScore.reset();
+    layOut();
+    phase = Phase::serving;
+}
+
+void Match::reseed(uint64_t seed) { random.reseed(seed); }
+
+// Everything back where a new match starts: paddles, ball, and chaos balls.
+void Match::layOut() {
+    const Vector2 ratio{6, 24};
+    const Vector2 fieldCenter{field.getCenter()};
+    ball.setPosition(fieldCenter.x, fieldCenter.y);
+    ball.setVelocity(0, 0);
+
+    // Left Player Paddle (player 1)
+    leftPaddle.setPosition(field.w / ratio.x, fieldCenter.y);
+
+    // Right Player Paddle (player 2)
+    rightPaddle.setPosition(field.w - (field.w / ratio.x), fieldCenter.y);
+
+    // Left Score
+    leftScore.setPosition(fieldCenter.x - (field.w / ratio.x), field.h / ratio.y);
+
+    // Right Score
+    rightScore.setPosition(fieldCenter.x + (field.w / ratio.x), field.h / ratio.y);
+
+    // Chaos Balls, fanned out over +/- 60 degrees, alternating sides
+    const float spread{2 * static_cast<float>(M_PI) / 3};
+    chaosBalls.clear();
+    chaosBalls.reserve(chaosBallCount);
+    for (uint32_t idx = 0; idx < chaosBallCount; ++idx) {
+        const float fraction{static_cast<float>(idx) / chaosBallCount};
+        const float radians{(fraction - 0.5f) * spread};
+        const float direction{idx % 2 ? -1.0f : 1.0f};
+        chaosBalls.add(fieldCenter.x - chaosSize / 2, fieldCenter.y - chaosSize / 2,
+                       chaosSize, chaosSize, direction * std::cos(radians) * chaosSpeed,
+                       std::sin(radians) * chaosSpeed);
+    }
+}
+
+void Match::serve() {
+    Vector2 fieldCenter{field.getCenter()};
+    ball.setPosition(fieldCenter.x, fieldCenter.y);
+    ball.randomizeVelocity(random);
+    rollAimError(Player::one);
+    rollAimError(Player::two);
+    rallyTicks = 0;
+    phase      = Phase::playing;
+}
+
+Match::Phase Match::step(float delta) {
+    PROFILE_ZONE("Match::step");
+    ++statistics.ticks;
+
+    // --- Snapshot (for render interpolation)
+
+    ball.snapshot();
+    leftPaddle.snapshot();
+    rightPaddle.snapshot();
+
+    // --- Update
+
+    steerPaddles();
+    leftPaddle.update(delta);
+    rightPaddle.update(delta);
+    clampPaddles();
+
+    // --- Ball (swept, so it cannot tunnel through anything thin)
+
+    sweepBall(delta);
+
+    // --- Chaos Balls (stream over the whole store, one phase at a time)
+
+    if (chaosBalls.size()) {
+        PROFILE_ZONE("Match::chaosBalls");
+        chaosBalls.snapshot();
+        chaosBalls.integrate(delta);
+        chaosBalls.bounceWithin(field);
+        chaosBalls.bounceOff(leftPaddle.getRect());
+        chaosBalls.bounceOff(rightPaddle.getRect());
+        recycleChaosBalls();
+        resolveChaosCollisions();
+    }
+
+    // --- Collide
+
+    resolveFrameCollisions();
+
+    // Nobody is ever going to miss; call it off rather than play forever.
+    if (phase == Phase::playing && maxRallyTicks && ++rallyTicks >= maxRallyTicks) {
+        phase = Phase::over;
+        ++statistics.abandoned;
+    }
+
+    if (phase == Phase::over) {
+        ++statistics.matches;
+    }
+
+    return phase;
+}
+
+void Match::play(float delta) {
+    reset();
+    while (phase != Phase::over) {
+        serve();
+        while (step(delta) == Phase::playing) {
+        }
+    }
+}
+
+Match::Phase Match::getPhase() const { return phase; }
+
+// -----------------------------------------------------------------------------
+// Access
+// -----------------------------------------------------------------------------
+
+const Rect& Match::getField() const { return field; }
+const Paddle& Match::getLeftPaddle() const { return leftPaddle; }
+const Paddle& Match::getRightPaddle() const { return rightPaddle; }
+const Ball& Match::getBall() const { return ball; }
+const Score& Match::getLeftScore() const { return leftScore; }
+const Score& Match::getRightScore() const { return rightScore; }
+const BodyStore& Match::getChaosBalls() const { return chaosBalls; }
+const std::vector<Rect>& Match::getObstacles() const { return obstacles; }
+const Match::Statistics& Match::getStatistics() const { return statistics; }
+
+Match::Statistics& Match::Statistics::operator+=(const Statistics& rhs) {
+    ticks += rhs.ticks;
+    matches += rhs.matches;
+    points += rhs.points;
+    returns += rhs.returns;
+    abandoned += rhs.abandoned;
+    return *this;
+}
+
+// -----------------------------------------------------------------------------
+// Rules Processing (Collision, Goals, Score, etc)
+// -----------------------------------------------------------------------------
+
+void Match::clampPaddles() {
+    for (Paddle* paddle : {&leftPaddle, &rightPaddle}) {
+        if (paddle->getTopEdgePosition() < field.y) {
+            // Align to top of field
+            paddle->setTopEdgePosition(field.y);
+        } else if (paddle->getBottomEdgePosition() > field.y + field.h) {
+            // Align to bottom of field
+            paddle->setBottomEdgePosition(field.y + field.h);
+        }
+    }
+}
+
+void Match::sweepBall(float delta) {
+    PROFILE_ZONE("Match::sweepBall");
+    // Walls as boxes just outside the field, so they can be swept against.
+    const Rect topWall{field.x - field.w, field.y - field.h, 3 * field.w, field.h};
+    const Rect bottomWall{field.x - field.w, field.y + field.h, 3 * field.w, field.h};
+
+    // Paddles have already moved this tick; the ball is swept against where
+    // they ended up. Each pass moves the ball up to its earliest impact,
+    // responds, and carries on with what is left of the tick.
+    // Motion itself is fixed-point; impacts are found between the whole-pixel
+    // boxes the ball rounds to at either end of each pass.
+    const Fixed tick{Fixed::fromFloat(delta)};
+    Fixed remaining{Fixed::fromInt(1)};
+    for (int impacts = 0; impacts <= maxImpactsPerTick; ++impacts) {
+        const FixedVector2 motion{ball.getFixedVelocity() * (tick * remaining)};
+        const Rect start{ball.getRect()};
+        const Vector2 displacement{
+            (ball.getFixedTopLeft() + motion).toVector2() -
+                ball.getFixedTopLeft().toVector2(),
+        };
+        if (displacement.isOrigin()) {
+            ball.translate(motion);
+            return;
+        }
+
+        Rect::Impact earliest{1, Rect::Edge::none};
+        const Rect* target{nullptr};
+        const auto sweep = [&](const Rect& rect) {
+            const Rect::Impact impact{rect.getSweptImpact(start, displacement)};
+            if (impact.edge != Rect::Edge::none && impact.time < earliest.time) {
+                earliest = impact;
+                target   = &rect;
+            }
+        };
+        const Rect leftRect{leftPaddle.getRect()};
+        const Rect rightRect{rightPaddle.getRect()};
+        sweep(leftRect);
+        sweep(rightRect);
+        sweep(topWall);
+        sweep(bottomWall);
+        for (const Rect& obstacle : obstacles) {
+            sweep(obstacle);
+        }
+
+        // Out of impacts: finish the tick unobstructed, and let the
+        // discrete tests in `resolveFrameCollisions` mop up.
+        if (!target || impacts == maxImpactsPerTick) {
+            ball.translate(motion);
+            return;
+        }
+
+        const Fixed time{Fixed::fromFloat(earliest.time)};
+        ball.translate(motion * time);
+        if (target == &leftRect) {
+            bounceBallOffPaddle(Player::one);
+        } else if (target == &rightRect) {
+            bounceBallOffPaddle(Player::two);
+        } else {
+            bounceBallOffEdge(earliest.edge);
+        }
+        remaining = remaining * (Fixed::fromInt(1) - time);
+    }
+}
+
+void Match::resolveFrameCollisions() {
+    PROFILE_ZONE("Match::resolveFrameCollisions");
+    Ball& b{ball};
+    Rect& f{field};
+
+    // --- Ball & Field
+    if (b.getTopEdgePosition() < f.y) {
+        bounceBallOffEdge(Rect::Edge::bottom);
+    } else if (b.getBottomEdgePosition() > f.y + f.h) {
+        bounceBallOffEdge(Rect::Edge::top);
+    } else if (b.getLeftEdgePosition() < f.x) {
+        // Delegate field-goal handler
+        handleLeftGoal();
+    } else if (b.getRightEdgePosition() > f.x + f.w) {
+        // Delegate field-goal handler
+        handleRightGoal();
+    }
+
+    // --- Ball & Paddles (overlapping from the start, e.g. a paddle moved
+    // onto the ball, so the sweep did not see them)
+    if ((leftPaddle.getRect() - b.getRect()).hasPoint(0, 0)) {
+        bounceBallOffPaddle(Player::one);
+    }
+    if ((rightPaddle.getRect() - b.getRect()).hasPoint(0, 0)) {
+        bounceBallOffPaddle(Player::two);
+    }
+
+    // --- Ball & Obstacles
+    for (const Rect& obstacle : obstacles) {
+        bounceBallOffEdge(obstacle.getIntersectingEdge(b.getRect()));
+    }
+}
+
+void Match::bounceBallOffPaddle(Player player) {
+    const Vector2 v{ball.getVelocity()};
+    if (player == Player::one) {
+        if (v.x < 0) {
+            ++statistics.returns;
+            rollAimError(Player::two);
+        }
+        ball.setVelocity(std::abs(v.x), v.y);
+    } else {
+        if (v.x > 0) {
+            ++statistics.returns;
+            rollAimError(Player::one);
+        }
+        ball.setVelocity(-std::abs(v.x), v.y);
+    }
+}
+
+void Match::bounceBallOffEdge(Rect::Edge edge) {
+    // Send the ball back out through the edge it hit.
+    const Vector2 v{ball.getVelocity()};
+    switch (edge) {
+    case Rect::Edge::left:
+        ball.setVelocity(-std::abs(v.x), v.y);
+        break;
+    case Rect::Edge::right:
+        ball.setVelocity(std::abs(v.x), v.y);
+        break;
+    case Rect::Edge::top:
+        ball.setVelocity(v.x, -std::abs(v.y));
+        break;
+    case Rect::Edge::bottom:
+        ball.setVelocity(v.x, std::abs(v.y));
+        break;
+    default:
+        break;
+    }
+}
+
+void Match::recycleChaosBalls() {
+    const float left{static_cast<float>(field.x)};
+    const float right{static_cast<float>(field.x + field.w)};
+    const float centerX{field.getCenter().x - chaosSize / 2};
+    const float centerY{field.getCenter().y - chaosSize / 2};
+
+    const std::size_t count{chaosBalls.size()};
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        const float x{chaosBalls.x[idx]};
+        if (x + chaosBalls.w[idx] < left || x > right) {
+            chaosBalls.x[idx]         = centerX;
+            chaosBalls.y[idx]         = centerY;
+            chaosBalls.previousX[idx] = centerX;
+            chaosBalls.previousY[idx] = centerY;
+            chaosBalls.vx[idx]        = -chaosBalls.vx[idx];
+        }
+    }
+}
+
+void Match::resolveChaosCollisions() {
+    PROFILE_ZONE("Match::resolveChaosCollisions");
+    if (!chaosCollisions && obstacles.empty()) {
+        return;
+    }
+
+    world.clear();
+    const std::size_t count{chaosBalls.size()};
+    for (std::size_t idx = 0; idx < count; ++idx) {
+        world.add(chaosBalls.x[idx], chaosBalls.y[idx], chaosBalls.w[idx],
+                  chaosBalls.h[idx]);
+    }
+    for (const Rect& obstacle : obstacles) {
+        world.add(obstacle.x, obstacle.y, obstacle.w, obstacle.h);
+    }
+    world.build();
+
+    if (chaosCollisions) {
+        // One pass finds both ball-ball and ball-obstacle pairs.
+        pairs.clear();
+        world.findPairs(pairs);
+        for (const CollisionWorld::Pair& pair : pairs) {
+            if (pair.b < count) {
+                collideChaosBalls(pair.a, pair.b);
+            } else if (pair.a < count) {
+                bounceChaosBall(pair.a, obstacles[pair.b - count]);
+            }
+        }
+        return;
+    }
+
+    // Balls pass through each other; only look around the obstacles.
+    for (const Rect& obstacle : obstacles) {
+        hits.clear();
+        world.query(obstacle, hits);
+        for (CollisionWorld::Id id : hits) {
+            if (id < count) {
+                bounceChaosBall(id, obstacle);
+            }
+        }
+    }
+}
+
+void Match::collideChaosBalls(BodyStore::Index a, BodyStore::Index b) {
+    BodyStore& balls{chaosBalls};
+    const float overlapX{std::min(balls.x[a] + balls.w[a], balls.x[b] + balls.w[b]) -
+                         std::max(balls.x[a], balls.x[b])};
+    const float overlapY{std::min(balls.y[a] + balls.h[a], balls.y[b] + balls.h[b]) -
+                         std::max(balls.y[a], balls.y[b])};
+
+    // Push the balls apart along the axis of least penetration, and, while
+    // they approach, exchange velocity along it (equal masses). Without the
+    // push, balls spawned together would travel as one overlapping clump.
+    if (overlapX < overlapY) {
+        const float push{(balls.x[a] < balls.x[b] ? overlapX : -overlapX) / 2};
+        balls.x[a] -= push;
+        balls.x[b] += push;
+        if ((balls.x[b] - balls.x[a]) * (balls.vx[b] - balls.vx[a]) < 0) {
+            std::swap(balls.vx[a], balls.vx[b]);
+        }
+    } else {
+        const float push{(balls.y[a] < balls.y[b] ? overlapY : -overlapY) / 2};
+        balls.y[a] -= push;
+        balls.y[b] += push;
+        if ((balls.y[b] - balls.y[a]) * (balls.vy[b] - balls.vy[a]) < 0) {
+            std::swap(balls.vy[a], balls.vy[b]);
+        }
+    }
+}
+
+void Match::bounceChaosBall(BodyStore::Index index, const Rect& obstacle) {
+    BodyStore& balls{chaosBalls};
+    const float left{static_cast<float>(obstacle.x)};
+    const float top{static_cast<float>(obstacle.y)};
+    const float right{static_cast<float>(obstacle.x + obstacle.w)};
+    const float bottom{static_cast<float>(obstacle.y + obstacle.h)};
+    const float overlapX{std::min(balls.x[index] + balls.w[index], right) -
+                         std::max(balls.x[index], left)};
+    const float overlapY{std::min(balls.y[index] + balls.h[index], bottom) -
+                         std::max(balls.y[index], top)};
+
+    // Send the ball back out of the side it went in through.
+    if (overlapX < overlapY) {
+        const bool isLeftOf{balls.x[index] + balls.w[index] / 2 < (left + right) / 2};
+        const float speed{std::abs(balls.vx[index])};
+        balls.vx[index] = isLeftOf ? -speed : speed;
+    } else {
+        const bool isAbove{balls.y[index] + balls.h[index] / 2 < (top + bottom) / 2};
+        const float speed{std::abs(balls.vy[index])};
+        balls.vy[index] = isAbove ? -speed : speed;
+    }
+}
+
+void Match::handleLeftGoal() {
+    ++statistics.points;
+    leftScore.increment();
+    phase = leftScore.isAtMax() ? Phase::over : Phase::point;
+}
+
+void Match::handleRightGoal() {
+    ++statistics.points;
+    rightScore.increment();
+    phase = rightScore.isAtMax() ? Phase::over : Phase::point;
+}
+
+// -----------------------------------------------------------------------------
+// Steering
+// -----------------------------------------------------------------------------
+
+void Match::rollAimError(Player player) {
+    // Uniform in [-1, 1), scaled by pilot accuracy when steering.
+    (player == Player::one ? leftAimError : rightAimError) = random.nextSignedFloat();
+}
+
+void Match::steerPaddles() {
+    leftPaddle.steer(getPilotDirection(leftPilot, leftPaddle));
+    rightPaddle.steer(getPilotDirection(rightPilot, rightPaddle));
+}
+
+float Match::getPilotDirection(const Pilot& pilot, const Paddle& paddle) const {
+    const bool isLeft{paddle.getPlayer() == Player::one};
+
+    // --- Human
+    if (pilot.kind == Pilot::Kind::human) {
+        return isLeft ? getInputDifference(InputBus::Action::playerOneUp,
+                                           InputBus::Action::playerOneDown)
+                      : getInputDifference(InputBus::Action::playerTwoUp,
+                                           InputBus::Action::playerTwoDown);
+    }
+
+    // --- Computer
+    // Wait while the ball heads away, otherwise chase the ball's center
+    // (plus this return's aim error), with a small dead zone to avoid
+    // jittering around it.
+    const int vx{ball.getVelocity().x};
+    if ((isLeft && vx > 0) || (!isLeft && vx < 0)) {
+        return 0;
+    }
+
+    const float roll{isLeft ? leftAimError : rightAimError};
+    const float aimError{(1 - pilot.accuracy) * roll};
+    const int aim{ball.getRect().getCenter().y +
+                  static_cast<int>(aimError * paddle.getSize().y)};
+    const int offset{aim - paddle.getRect().getCenter().y};
+    const int deadZone{paddle.getSize().y / 8};
+    if (std::abs(offset) <= deadZone) {
+        return 0;
+    }
+    return offset < 0 ? -pilot.skill : pilot.skill;
+}
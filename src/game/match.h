@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/glyph_atlas.h"
+#include "core/random.h"
+#include "core/rect.h"
+#include "game/body_store.h"
+#include "game/collision_world.h"
+#include "game/entities/ball.h"
+#include "game/entities/paddle.h"
+#include "game/entities/score.h"
+#include "game/pilot.h"
+
+/**
+ * A single match of Pong: the field, both paddles, the ball, both scores,
+ * and the rules that tie them together.
+ *
+ * A `Match` is a self-contained simulation context. It does not touch the
+ * `App`, `Display`, or `Renderer` sub-systems (short of drawing its entities,
+ * which it never does itself), so any number of them may be simulated at
+ * once, on any thread. Only human pilots reach outside, into the `InputBus`.
+ *
+ * Rules state machine:
+ *
+ *     serving --serve()--> playing --step()--> point --serve()--> playing ...
+ *                                          \--> over  --reset()--> serving
+ *
+ * TODO: Tests
+ */
+class Match {
+  public:
+    struct Config {
+        Rect field;
+        Pilot leftPilot;
+        Pilot rightPilot;
+        Score::ValueType maxScore{6};
+        /** Glyphs used to draw the scores. Null when never drawn (headless). */
+        const GlyphAtlas* atlas{nullptr};
+        /**
+         * "Multiball chaos": extra balls that bounce off walls and paddles
+         * alongside the real one. They never score; one that leaves the
+         * field is sent back from the center toward the other side.
+         */
+        uint32_t chaosBalls{0};
+        /** Chaos balls also bounce off each other. */
+        bool chaosCollisions{false};
+        /** Static boxes that the ball and chaos balls bounce off. */
+        std::vector<Rect> obstacles{};
+        /**
+         * Seeds every random choice the match makes (serve angles, computer
+         * aim). Same seed, same pilots, same input: same match.
+         */
+        uint64_t seed{0};
+        /**
+         * Longest rally, in ticks, before the match is abandoned (ended, and
+         * counted in `Statistics::abandoned`). Accurate enough computer
+         * pilots never miss; this keeps such matches from running forever.
+         * Zero means no limit.
+         */
+        uint64_t maxRallyTicks{uint64_t{1} << 18};
+    };
+
+    /**
+     * Rules phase.
+     */
+    enum class Phase {
+        /** Waiting for `serve`. */
+        serving,
+        /** Ball in play; advance with `step`. */
+        playing,
+        /** A point was just scored; waiting for `serve`. */
+        point,
+        /** A side reached the maximum score; waiting for `reset`. */
+        over,
+    };
+
+    /**
+     * Running totals, mostly of interest to headless batch runs.
+     */
+    struct Statistics {
+        uint64_t ticks{0};
+        uint64_t matches{0};
+        uint64_t points{0};
+        /** Paddle hits, i.e. balls returned. */
+        uint64_t returns{0};
+        /** Matches ended by `Config::maxRallyTicks` (also in `matches`). */
+        uint64_t abandoned{0};
+
+        Statistics& operator+=(const Statistics& rhs);
+    };
+
+    Match(const Config& config);
+
+    Match(const Match&)            = delete;
+    Match(Match&&)                 = delete;
+    Match& operator=(const Match&) = delete;
+    Match& operator=(Match&&)      = delete;
+
+    // --- Rules
+
+    /**
+     * Clear both scores, put everything back where it started, and return
+     * to `Phase::serving`. Random choices carry on where the last match left
+     * them; see `reseed`.
+     */
+    void reset();
+
+    /**
+     * Restart the match's random sequence from `seed`. After `reset` and
+     * `reseed(seed)`, a match plays out exactly like a new one whose
+     * `Config::seed` is `seed`.
+     */
+    void reseed(uint64_t seed);
+
+    /**
+     * Put the ball back in the middle and launch it in a random direction.
+     */
+    void serve();
+
+    /**
+     * Advance a `Phase::playing` match by a single tick.
+     * Returns the resulting phase (`playing`, `point`, or `over`; also
+     * `over` once a rally outlasts `Config::maxRallyTicks`).
+     */
+    Phase step(float delta);
+
+    /**
+     * Play a whole match to completion (from `reset` to `Phase::over`).
+     * Only sensible with computer pilots. Always returns, see
+     * `Config::maxRallyTicks`.
+     */
+    void play(float delta);
+
+    Phase getPhase() const;
+
+    // --- Access
+
+    const Rect& getField() const;
+    const Paddle& getLeftPaddle() const;
+    const Paddle& getRightPaddle() const;
+    const Ball& getBall() const;
+    const Score& getLeftScore() const;
+    const Score& getRightScore() const;
+    const BodyStore& getChaosBalls() const;
+    const std::vector<Rect>& getObstacles() const;
+    const Statistics& getStatistics() const;
+
+  private:
+    // --- Data Members
+    Rect field;
+    Paddle leftPaddle;
+    Paddle rightPaddle;
+    Ball ball;
+    Score leftScore;
+    Score rightScore;
+    BodyStore chaosBalls;
+    uint32_t chaosBallCount;
+    std::vector<Rect> obstacles;
+    bool chaosCollisions;
+    Pilot leftPilot;
+    Pilot rightPilot;
+    Phase phase{Phase::serving};
+    uint64_t maxRallyTicks;
+    /** Ticks since the last serve. */
+    uint64_t rallyTicks{0};
+    Statistics statistics;
+    Random random;
+
+    /** Computer pilots' aim error for the current return, in [-1, 1]. */
+    float leftAimError{0};
+    float rightAimError{0};
+
+    /** Broad phase for chaos balls (Ids first) and obstacles (Ids after). */
+    CollisionWorld world;
+    std::vector<CollisionWorld::Pair> pairs;
+    std::vector<CollisionWorld::Id> hits;
+
+    // --- Rules (Collision, Goal, Score, etc.)
+    void layOut();
+    void handleLeftGoal();
+    void handleRightGoal();
+    void clampPaddles();
+    void sweepBall(float delta);
+    void resolveFrameCollisions();
+    void bounceBallOffPaddle(Player player);
+    void bounceBallOffEdge(Rect::Edge edge);
+    void recycleChaosBalls();
+    void resolveChaosCollisions();
+    void collideChaosBalls(BodyStore::Index a, BodyStore::Index b);
+    void bounceChaosBall(BodyStore::Index index, const Rect& obstacle);
+
+    // --- Steering
+    void steerPaddles();
+    float getPilotDirection(const Pilot& pilot, const Paddle& paddle) const;
+    void rollAimError(Player player);
+};
@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <mutex>
+
+#include "match_farm.h"
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+
+MatchFarm::MatchFarm(const Config& config)
+    : pool{config.threads},
+      matchesPerTask{std::max<uint64_t>(config.matchesPerTask, 1)} {}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+Match::Statistics MatchFarm::play(const Match::Config& config, uint64_t matches,
+                                  float delta) {
+    Match::Statistics totals;
+    std::mutex totalsMutex;
+
+    for (uint64_t first = 0; first < matches; first += matchesPerTask) {
+        const uint64_t count{std::min(matchesPerTask, matches - first)};
+        pool.submit([&config, &totals, &totalsMutex, first, count, delta]() {
+            // Seeded by task, not by thread, so totals don't depend on which
+            // worker ran what.
+            Match match{config};
+            match.reseed(config.seed + first);
+            for (uint64_t idx = 0; idx < count; ++idx) {
+                match.play(delta);
+            }
+
+            std::lock_guard lock{totalsMutex};
+            totals += match.getStatistics();
+        });
+    }
+
+    pool.wait();
+    return totals;
+}
+
+std::size_t MatchFarm::getThreadCount() const { return pool.getThreadCount(); }
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/thread_pool.h"
+#include "game/match.h"
+
+/**
+ * Plays batches of headless matches in parallel.
+ *
+ * Matches are split into tasks of `matchesPerTask` matches each; every task
+ * simulates its share in its own `Match` on a `ThreadPool` worker, so no
+ * simulation state is shared between threads until totals are summed up.
+ *
+ * TODO: Tests
+ */
+class MatchFarm {
+  public:
+    struct Config {
+        /** Worker threads. Zero means one per hardware thread. */
+        std::size_t threads{0};
+        /** Matches simulated per pool task; trades balance for overhead. */
+        uint64_t matchesPerTask{64};
+    };
+
+    MatchFarm(const Config& config);
+
+    /**
+     * Play `matches` complete matches of `match` at fixed tick `delta`.
+     * Blocks until all are finished and returns their combined totals, which
+     * are the same on every run for the same `match.seed`.
+     */
+    Match::Statistics play(const Match::Config& match, uint64_t matches, float delta);
+
+    std::size_t getThreadCount() const;
+
+  private:
+    ThreadPool pool;
+    uint64_t matchesPerTask;
+};
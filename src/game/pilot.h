@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * Describes who steers a paddle.
+ */
+struct Pilot {
+    enum class Kind {
+        /** Steered by player input through the `InputBus`. */
+        human,
+        /** Steered by a simple ball-tracking routine. */
+        computer,
+    };
+
+    Kind kind{Kind::human};
+
+    /**
+     * Computer only: fraction of full paddle speed, in (0, 1].
+     */
+    float skill{0.5f};
+
+    /**
+     * Computer only: how closely the paddle aims for the ball, in [0, 1].
+     * Every return is aimed at a random point up to `(1 - accuracy)` paddle
+     * heights away from the paddle's center. Bounces never change the ball's
+     * path, so a perfectly accurate tracker that once catches up never
+     * misses again, and never finishes a match. Above about 0.45 misses
+     * become rare enough that matches effectively never end, and are
+     * abandoned instead (see `Match::Config::maxRallyTicks`).
+     */
+    float accuracy{0.3f};
+};
@@ -0,0 +1,297 @@
+#include <bit>
+#include <fstream>
+#include <iterator>
+
+#include <spdlog/spdlog.h>
+
+#include "replay.h"
+
+static const std::string TAG{"Replay"};
+
+static const char magic[8]{'P', 'O', 'N', 'G', 'R', 'P', 'L', '\0'};
+
+/** About three weeks at 60 Hz; far beyond any real match. */
+static const uint64_t maxTicks{uint64_t{1} << 27};
+
+/** Far beyond what the simulation keeps up with. */
+static const uint32_t maxChaosBalls{uint32_t{1} << 20};
+
+/** Largest field (or obstacle) coordinate and size; corners stay `Fixed`. */
+static const int maxFieldExtent{16383};
+
+// -----------------------------------------------------------------------------
+// Static Function Components
+// -----------------------------------------------------------------------------
+
+/** Non-empty, and within reach of `Fixed` positions. */
+static bool isSane(const Rect& rect) {
+    return rect.w > 0 && rect.h > 0 && rect.w <= maxFieldExtent &&
+           rect.h <= maxFieldExtent && rect.x >= -maxFieldExtent &&
+           rect.x <= maxFieldExtent && rect.y >= -maxFieldExtent &&
+           rect.y <= maxFieldExtent;
+}
+
+static void putVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+static void putSigned(std::vector<uint8_t>& bytes, int64_t value) {
+    putVarint(bytes, (static_cast<uint64_t>(value) << 1) ^
+                         static_cast<uint64_t>(value >> 63));
+}
+
+static void putFloat(std::vector<uint8_t>& bytes, float value) {
+    const uint32_t bits{std::bit_cast<uint32_t>(value)};
+    for (int shift = 0; shift < 32; shift += 8) {
+        bytes.push_back(static_cast<uint8_t>(bits >> shift));
+    }
+}
+
+static void putRect(std::vector<uint8_t>& bytes, const Rect& rect) {
+    for (int value : {rect.x, rect.y, rect.w, rect.h}) {
+        putSigned(bytes, value);
+    }
+}
+
+static void putPilot(std::vector<uint8_t>& bytes, const Pilot& pilot) {
+    putVarint(bytes, static_cast<uint64_t>(pilot.kind));
+    putFloat(bytes, pilot.skill);
+    putFloat(bytes, pilot.accuracy);
+}
+
+/**
+ * Bounds-checked reads. Any read past the end sets `failed` and yields zero,
+ * so callers check once at the end.
+ */
+struct Reader {
+    const std::vector<uint8_t>& bytes;
+    std::size_t offset{0};
+    bool failed{false};
+
+    uint64_t getVarint() {
+        uint64_t value{0};
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset >= bytes.size()) {
+                failed = true;
+                return 0;
+            }
+            const uint8_t byte{bytes[offset++]};
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+
+    int64_t getSigned() {
+        const uint64_t value{getVarint()};
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    float getFloat() {
+        if (bytes.size() - offset < 4) {
+            failed = true;
+            return 0;
+        }
+        uint32_t bits{0};
+        for (int shift = 0; shift < 32; shift += 8) {
+            bits |= static_cast<uint32_t>(bytes[offset++]) << shift;
+        }
+        return std::bit_cast<float>(bits);
+    }
+
+    Rect getRect() {
+        const int x{static_cast<int>(getSigned())};
+        const int y{static_cast<int>(getSigned())};
+        const int w{static_cast<int>(getSigned())};
+        const int h{static_cast<int>(getSigned())};
+        return Rect{x, y, w, h};
+    }
+
+    Pilot getPilot() {
+        Pilot pilot;
+        pilot.kind     = getVarint() ? Pilot::Kind::computer : Pilot::Kind::human;
+        pilot.skill    = getFloat();
+        pilot.accuracy = getFloat();
+        return pilot;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Encoding
+// -----------------------------------------------------------------------------
+
+std::vector<uint8_t> Replay::encode() const {
+    std::vector<uint8_t> bytes(std::begin(magic), std::end(magic));
+    putVarint(bytes, version);
+    putVarint(bytes, match.seed);
+    putVarint(bytes, tickRate);
+
+    putRect(bytes, match.field);
+    putVarint(bytes, match.maxScore);
+    putPilot(bytes, match.leftPilot);
+    putPilot(bytes, match.rightPilot);
+    putVarint(bytes, match.chaosBalls);
+    putVarint(bytes, match.chaosCollisions);
+    putVarint(bytes, match.obstacles.size());
+    for (const Rect& obstacle : match.obstacles) {
+        putRect(bytes, obstacle);
+    }
+
+    putVarint(bytes, leftScore);
+    putVarint(bytes, rightScore);
+    putVarint(bytes, ticks.size());
+
+    // --- Runs of unchanged action sets, as (length, change)
+    InputBus::ActionSet previous{0};
+    for (std::size_t start = 0; start < ticks.size();) {
+        std::size_t end{start + 1};
+        while (end < ticks.size() && ticks[end] == ticks[start]) {
+            ++end;
+        }
+        putVarint(bytes, end - start);
+        putVarint(bytes, ticks[start] ^ previous);
+        previous = ticks[start];
+        start    = end;
+    }
+    return bytes;
+}
+
+bool Replay::decode(const std::vector<uint8_t>& bytes, Replay& replay) {
+    if (bytes.size() < sizeof(magic) ||
+        !std::equal(std::begin(magic), std::end(magic), bytes.begin())) {
+        spdlog::error("{} Error: Not a replay (bad magic)!", TAG);
+        return false;
+    }
+    Reader reader{bytes, sizeof(magic)};
+    if (const uint64_t fileVersion{reader.getVarint()}; fileVersion != version) {
+        spdlog::error("{} Error: Unsupported version {}!", TAG, fileVersion);
+        return false;
+    }
+    Match::Config& match{replay.match};
+    match.seed      = reader.getVarint();
+    replay.tickRate = static_cast<uint32_t>(reader.getVarint());
+
+    match.field      = reader.getRect();
+    match.maxScore   = static_cast<Score::ValueType>(reader.getVarint());
+    match.leftPilot  = reader.getPilot();
+    match.rightPilot = reader.getPilot();
+    match.atlas      = nullptr;
+    match.chaosBalls = static_cast<uint32_t>(reader.getVarint());
+    match.chaosCollisions = reader.getVarint() != 0;
+    const uint64_t obstacleCount{reader.getVarint()};
+    match.obstacles.clear();
+    for (uint64_t idx = 0; idx < obstacleCount && !reader.failed; ++idx) {
+        match.obstacles.push_back(reader.getRect());
+    }
+
+    replay.leftScore  = static_cast<Score::ValueType>(reader.getVarint());
+    replay.rightScore = static_cast<Score::ValueType>(reader.getVarint());
+    const uint64_t tickCount{reader.getVarint()};
+
+    // --- Setup
+    // Everything here goes straight into a `Match`; a zero tick rate, a
+    // huge chaos ball count, or an empty field would be a division by zero,
+    // a huge allocation, or a broken collision grid.
+    bool isSetupSane{replay.tickRate > 0 && match.chaosBalls <= maxChaosBalls &&
+                     isSane(match.field)};
+    for (const Rect& obstacle : match.obstacles) {
+        isSetupSane &= isSane(obstacle);
+    }
+    if (!isSetupSane) {
+        reader.failed = true;
+    }
+
+    // --- Runs
+    // A corrupt tick count must not turn into a huge allocation.
+    if (tickCount > maxTicks) {
+        spdlog::error("{} Error: Replay claims {} ticks!", TAG, tickCount);
+        return false;
+    }
+    replay.ticks.clear();
+    InputBus::ActionSet current{0};
+    while (replay.ticks.size() < tickCount && !reader.failed) {
+        const uint64_t length{reader.getVarint()};
+        current ^= static_cast<InputBus::ActionSet>(reader.getVarint());
+        if (!length || length > tickCount - replay.ticks.size()) {
+            reader.failed = true;
+            break;
+        }
+        replay.ticks.insert(replay.ticks.end(), length, current);
+    }
+
+    if (reader.failed || reader.offset != bytes.size()) {
+        spdlog::error("{} Error: Replay is truncated or corrupt!", TAG);
+        return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Files
+// -----------------------------------------------------------------------------
+
+bool Replay::save(const std::string& path) const {
+    const std::vector<uint8_t> bytes{encode()};
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        spdlog::error("{} Error: Could not write {}!", TAG, path);
+        return false;
+    }
+    spdlog::info("{}: Saved {} ticks in {} bytes to {}.", TAG, ticks.size(),
+                 bytes.size(), path);
+    return true;
+}
+
+bool Replay::load(const std::string& path, Replay& replay) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file) {
+        spdlog::error("{} Error: Could not open {}!", TAG, path);
+        return false;
+    }
+    const std::vector<uint8_t> bytes{std::istreambuf_iterator<char>{file},
+                                     std::istreambuf_iterator<char>{}};
+    return decode(bytes, replay);
+}
+
+// -----------------------------------------------------------------------------
+// Playback
+// -----------------------------------------------------------------------------
+
+ReplayPlayer::Outcome ReplayPlayer::play(const Replay& replay) {
+    InputBus& input{InputBus::get()};
+    const float delta{1.0f / replay.tickRate};
+
+    // Same sequence as `Game`: reset, serve, step until a point, serve ...
+    Match match{replay.match};
+    match.reset();
+    match.serve();
+
+    Outcome outcome;
+    for (InputBus::ActionSet actions : replay.ticks) {
+        input.setActionState(actions);
+        ++outcome.ticks;
+        const Match::Phase phase{match.step(delta)};
+        if (phase == Match::Phase::over) {
+            break;
+        }
+        if (phase == Match::Phase::point) {
+            match.serve();
+        }
+    }
+
+    outcome.leftScore  = match.getLeftScore().getValue();
+    outcome.rightScore = match.getRightScore().getValue();
+    outcome.matches    = outcome.leftScore == replay.leftScore &&
+                      outcome.rightScore == replay.rightScore &&
+                      outcome.ticks == replay.ticks.size();
+    return outcome;
+}
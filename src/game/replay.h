@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "game/input_bus.h"
+#include "game/match.h"
+
+/**
+ * A recorded match: everything needed to play it again exactly.
+ *
+ * That is the match setup (including `Match::Config::seed`) and the actions
+ * held on every simulation tick (`InputBus::ActionSet`). Only ticks that
+ * advance the match are recorded; pauses and countdowns don't affect the
+ * outcome. The final score is kept too, so a replay can check itself.
+ *
+ * File format (little-endian, integers as LEB128 varints, signed ones
+ * zigzag-encoded, floats as raw 4-byte IEEE 754):
+ *
+ *     "PONGRPL" '\0', version
+ *     seed, tick rate
+ *     field (x, y, w, h), max score
+ *     left pilot, right pilot (kind, skill, accuracy)
+ *     chaos balls, chaos collisions, obstacle count, obstacles (x, y, w, h)
+ *     left score, right score, tick count
+ *     runs: (tick count, action set XOR the previous run's) ... until every
+ *           tick is accounted for
+ *
+ * Held actions change rarely, so runs are few and most varints one byte.
+ */
+struct Replay {
+    static constexpr uint32_t version{2};
+
+    uint32_t tickRate{60};
+    /** `atlas` is never stored (always null). */
+    Match::Config match{};
+    std::vector<InputBus::ActionSet> ticks{};
+    Score::ValueType leftScore{0};
+    Score::ValueType rightScore{0};
+
+    std::vector<uint8_t> encode() const;
+    /**
+     * Returns false (leaving `replay` unspecified) if `bytes` are malformed,
+     * or describe a match that can't be played: no tick rate, an empty or
+     * out-of-range field or obstacle, or an absurd number of chaos balls.
+     */
+    static bool decode(const std::vector<uint8_t>& bytes, Replay& replay);
+
+    bool save(const std::string& path) const;
+    static bool load(const std::string& path, Replay& replay);
+};
+
+/**
+ * Plays a `Replay` back through the `InputBus` as fast as the simulation
+ * runs: no window, no frame pacing.
+ */
+class ReplayPlayer {
+  public:
+    struct Outcome {
+        Score::ValueType leftScore{0};
+        Score::ValueType rightScore{0};
+        uint64_t ticks{0};
+        /** Final score as recorded. */
+        bool matches{false};
+    };
+
+    static Outcome play(const Replay& replay);
+};
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "core/inplace_function.h"
+#include "core/tests/test.h"
+#include "game/input_bus.h"
+
+/**
+ * `InplaceFunction` ownership, and the `InputBus` observer table: swap-pop
+ * unsubscription from anywhere in the table, stale handles rejected once
+ * their slot is reused, and `Subscription` move and reset semantics.
+ */
+
+struct InputBusTests {
+    /** A copy of `subscription`'s handle that won't unsubscribe anything. */
+    static std::pair<uint32_t, uint32_t>
+    getHandle(const InputBus::Subscription& subscription) {
+        return {subscription.handle, subscription.generation};
+    }
+
+    static void unsubscribe(std::pair<uint32_t, uint32_t> handle) {
+        InputBus::get().unsubscribe(handle.first, handle.second);
+    }
+
+    static std::size_t getObserverCount() { return InputBus::get().observers.size(); }
+};
+
+// -----------------------------------------------------------------------------
+// InplaceFunction
+// -----------------------------------------------------------------------------
+
+/** Counts live copies of itself, so leaks and double destruction show. */
+struct Counted {
+    int* live;
+    int value;
+
+    Counted(int* live, int value) : live{live}, value{value} { ++*live; }
+    Counted(Counted&& other) noexcept : live{other.live}, value{other.value} {
+        ++*live;
+    }
+    ~Counted() { --*live; }
+
+    int operator()(int argument) const { return value + argument; }
+};
+
+static void checkInplaceFunction() {
+    int live{0};
+    {
+        InplaceFunction<int(int)> empty;
+        CHECK(!empty);
+
+        InplaceFunction<int(int)> function{Counted{&live, 10}};
+        CHECK(function);
+        CHECK(function(5) == 15);
+        CHECK(live == 1);
+
+        // --- Move construction takes the callable and empties the source
+        InplaceFunction<int(int)> moved{std::move(function)};
+        CHECK(!function);
+        CHECK(moved && moved(1) == 11);
+        CHECK(live == 1);
+
+        // --- Move assignment destroys what was there first
+        InplaceFunction<int(int)> other{Counted{&live, 100}};
+        CHECK(live == 2);
+        other = std::move(moved);
+        CHECK(live == 1);
+        CHECK(!moved);
+        CHECK(other(1) == 11);
+
+        // --- Reset destroys; resetting again does nothing
+        other.reset();
+        CHECK(!other);
+        CHECK(live == 0);
+        other.reset();
+        CHECK(live == 0);
+
+        function = InplaceFunction<int(int)>{Counted{&live, 20}};
+        CHECK(live == 1);
+    }
+    // --- Destruction destroys
+    CHECK(live == 0);
+}
+
+// -----------------------------------------------------------------------------
+// InputBus Subscriptions
+// -----------------------------------------------------------------------------
+
+/** Dispatch one press; `received` collects which observers saw it. */
+static std::vector<int> press(std::vector<int>& received) {
+    SDL_KeyboardEvent event{};
+    event.keysym.scancode = SDL_SCANCODE_P;
+    received.clear();
+    InputBus::get().handleKeyDownEvent(event);
+    std::vector<int> sorted{received};
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+static void checkSubscriptions() {
+    InputBus& input{InputBus::get()};
+    std::vector<int> received;
+    const auto observer{[&received](int id) {
+        return [&received, id](InputBus::Action action) {
+            if (action == InputBus::Action::pause) {
+                received.push_back(id);
+            }
+        };
+    }};
+
+    // --- Every observer sees every press, once
+    std::vector<InputBus::Subscription> subscriptions;
+    for (int id = 0; id < 5; ++id) {
+        subscriptions.push_back(input.onActionPressed(observer(id)));
+        CHECK(subscriptions.back().isSubscribed());
+    }
+    CHECK((press(received) == std::vector<int>{0, 1, 2, 3, 4}));
+
+    // --- Unsubscribing from the middle moves the last observer into the gap
+    subscriptions[1].reset();
+    CHECK(!subscriptions[1].isSubscribed());
+    CHECK(InputBusTests::getObserverCount() == 4);
+    CHECK((press(received) == std::vector<int>{0, 2, 3, 4}));
+    // ... and the moved observer's handle still finds it
+    subscriptions[4].reset();
+    CHECK((press(received) == std::vector<int>{0, 2, 3}));
+    // ... as do those at either end
+    subscriptions[0].reset();
+    CHECK((press(received) == std::vector<int>{2, 3}));
+
+    // --- A stale handle does nothing once its slot is reused
+    InputBus::Subscription doomed{input.onActionPressed(observer(5))};
+    const auto stale{InputBusTests::getHandle(doomed)};
+    doomed.reset();
+    InputBus::Subscription reused{input.onActionPressed(observer(6))};
+    CHECK(InputBusTests::getHandle(reused).first == stale.first);
+    CHECK(InputBusTests::getHandle(reused).second != stale.second);
+    InputBusTests::unsubscribe(stale);
+    CHECK((press(received) == std::vector<int>{2, 3, 6}));
+    // Out-of-range handles are ignored too.
+    InputBusTests::unsubscribe({UINT32_MAX, 1});
+    CHECK((press(received) == std::vector<int>{2, 3, 6}));
+
+    // --- Moving a subscription moves ownership, not the observer
+    InputBus::Subscription moved{std::move(reused)};
+    CHECK(!reused.isSubscribed());
+    CHECK(moved.isSubscribed());
+    reused.reset(); // Moved-from: nothing to unsubscribe
+    CHECK((press(received) == std::vector<int>{2, 3, 6}));
+
+    // --- Move assignment unsubscribes what it overwrites
+    moved = std::move(subscriptions[2]);
+    CHECK(!subscriptions[2].isSubscribed());
+    CHECK((press(received) == std::vector<int>{2, 3}));
+
+    // --- offActionPressed is reset; resetting again does nothing
+    input.offActionPressed(moved);
+    CHECK(!moved.isSubscribed());
+    moved.reset();
+    CHECK((press(received) == std::vector<int>{3}));
+
+    // --- Destruction unsubscribes
+    {
+        InputBus::Subscription scoped{input.onActionPressed(observer(7))};
+        CHECK((press(received) == std::vector<int>{3, 7}));
+    }
+    CHECK((press(received) == std::vector<int>{3}));
+
+    subscriptions.clear();
+    CHECK(press(received).empty());
+    CHECK(InputBusTests::getObserverCount() == 0);
+}
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+
+    InputBus::Config config;
+    config.setKeyboardKeyDownAction(SDL_SCANCODE_P, InputBus::Action::pause);
+    InputBus::get().initialize(config);
+
+    checkInplaceFunction();
+    checkSubscriptions();
+
+    InputBus::get().terminate();
+    return finishTests();
+}
@@ -0,0 +1,62 @@
+#include <spdlog/spdlog.h>
+
+#include "core/tests/test.h"
+#include "game/match.h"
+#include "game/match_farm.h"
+
+/**
+ * Matches between computer pilots too accurate to ever miss still finish:
+ * the rally limit abandons them. Ordinary matches are left alone.
+ */
+
+static Match::Config makeConfig(float accuracy) {
+    return {
+        .field      = Rect{0, 0, 256, 256},
+        .leftPilot  = {.kind = Pilot::Kind::computer, .accuracy = accuracy},
+        .rightPilot = {.kind = Pilot::Kind::computer, .accuracy = accuracy},
+        .seed       = 7,
+    };
+}
+
+int main() {
+    spdlog::set_level(spdlog::level::warn);
+    const float delta{1.0f / 60};
+
+    // --- Perfect pilots: the first rally is abandoned, at the limit
+    {
+        Match::Config config{makeConfig(1)};
+        config.maxRallyTicks = 10000;
+        Match match{config};
+        match.play(delta);
+        CHECK(match.getPhase() == Match::Phase::over);
+        CHECK(match.getStatistics().matches == 1);
+        CHECK(match.getStatistics().abandoned == 1);
+        CHECK(match.getStatistics().ticks == config.maxRallyTicks);
+    }
+
+    // --- Beyond the "effectively never" threshold, with the default limit
+    {
+        Match match{makeConfig(0.6f)};
+        match.play(delta);
+        CHECK(match.getPhase() == Match::Phase::over);
+        CHECK(match.getStatistics().matches == 1);
+    }
+
+    // --- The whole farm returns too (each task plays matches in turn)
+    {
+        MatchFarm farm{{.threads = 2}};
+        const Match::Statistics stats{farm.play(makeConfig(0.9f), 4, delta)};
+        CHECK(stats.matches == 4);
+        CHECK(stats.abandoned > 0);
+    }
+
+    // --- Ordinary pilots miss long before the limit
+    {
+        Match match{makeConfig(Pilot{}.accuracy)};
+        match.play(delta);
+        CHECK(match.getStatistics().matches == 1);
+        CHECK(match.getStatistics().abandoned == 0);
+    }
+
+    return finishTests();
+}
@@ -0,0 +1,192 @@
+#include <cstdint>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "core/tests/test.h"
+#include "game/replay.h"
+
+/**
+ * `Replay` encoding round trips, malformed files are rejected, and a
+ * recorded computer-vs-computer match plays back to the same score.
+ */
+
+static bool isSameRect(const Rect& a, const Rect& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static bool isSamePilot(const Pilot& a, const Pilot& b) {
+    return a.kind == b.kind && a.skill == b.skill && a.accuracy == b.accuracy;
+}
+
+static Replay makeReplay() {
+    Replay replay;
+    replay.tickRate = 120;
+    replay.match    = {
+        .field           = Rect{-8, 16, 300, 200},
+        .leftPilot       = {.kind = Pilot::Kind::human},
+        .rightPilot      = {.kind = Pilot::Kind::computer, .skill = 0.75f},
+        .maxScore        = 11,
+        .chaosBalls      = 300,
+        .chaosCollisions = true,
+        .obstacles       = {Rect{120, 40, 16, 16}, Rect{-4, -4, 1, 1}},
+        .seed            = 0xfedcba9876543210,
+    };
+    replay.leftScore  = 11;
+    replay.rightScore = 7;
+
+    // Long runs (multi-byte lengths), short ones, and every change shape:
+    // press, release, several at once, and back to nothing.
+    const InputBus::ActionSet up{InputBus::getActionBit(InputBus::Action::playerOneUp)};
+    const InputBus::ActionSet down{
+        InputBus::getActionBit(InputBus::Action::playerOneDown)};
+    const InputBus::ActionSet pause{InputBus::getActionBit(InputBus::Action::pause)};
+    const struct {
+        std::size_t length;
+        InputBus::ActionSet held;
+    } runs[]{{100000, 0}, {1, up},         {3, up | down}, {200, down},
+             {1, 0},      {1, up | pause}, {20000, pause}, {1, 0xffffffff},
+             {7, 0}};
+    for (const auto& run : runs) {
+        replay.ticks.insert(replay.ticks.end(), run.length, run.held);
+    }
+    return replay;
+}
+
+static void checkRoundTrip() {
+    const Replay replay{makeReplay()};
+    const std::vector<uint8_t> bytes{replay.encode()};
+    // Runs, not ticks, are stored.
+    CHECK(bytes.size() < 256);
+
+    Replay decoded;
+    CHECK(Replay::decode(bytes, decoded));
+    CHECK(decoded.tickRate == replay.tickRate);
+    CHECK(isSameRect(decoded.match.field, replay.match.field));
+    CHECK(isSamePilot(decoded.match.leftPilot, replay.match.leftPilot));
+    CHECK(isSamePilot(decoded.match.rightPilot, replay.match.rightPilot));
+    CHECK(decoded.match.maxScore == replay.match.maxScore);
+    CHECK(decoded.match.atlas == nullptr);
+    CHECK(decoded.match.chaosBalls == replay.match.chaosBalls);
+    CHECK(decoded.match.chaosCollisions == replay.match.chaosCollisions);
+    CHECK(decoded.match.obstacles.size() == replay.match.obstacles.size());
+    for (std::size_t idx = 0; idx < decoded.match.obstacles.size() &&
+                              idx < replay.match.obstacles.size();
+         ++idx) {
+        CHECK(isSameRect(decoded.match.obstacles[idx], replay.match.obstacles[idx]));
+    }
+    CHECK(decoded.match.seed == replay.match.seed);
+    CHECK(decoded.leftScore == replay.leftScore);
+    CHECK(decoded.rightScore == replay.rightScore);
+    CHECK(decoded.ticks == replay.ticks);
+
+    // Nothing held at all is a single run.
+    Replay idle{makeReplay()};
+    idle.ticks.assign(5000, 0);
+    CHECK(Replay::decode(idle.encode(), decoded));
+    CHECK(decoded.ticks == idle.ticks);
+}
+
+static void checkRejected() {
+    const std::vector<uint8_t> bytes{makeReplay().encode()};
+    Replay decoded;
+
+    // --- Truncated anywhere
+    for (std::size_t size = 0; size < bytes.size(); ++size) {
+        const std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + size);
+        CHECK(!Replay::decode(truncated, decoded));
+    }
+
+    // --- Trailing bytes
+    std::vector<uint8_t> trailing{bytes};
+    trailing.push_back(0);
+    CHECK(!Replay::decode(trailing, decoded));
+
+    // --- Bad magic
+    std::vector<uint8_t> badMagic{bytes};
+    badMagic[0] = 'X';
+    CHECK(!Replay::decode(badMagic, decoded));
+
+    // --- Wrong version (the byte after the magic; versions are one byte)
+    for (uint8_t version : {uint8_t{0}, uint8_t{Replay::version - 1},
+                            uint8_t{Replay::version + 1}}) {
+        std::vector<uint8_t> wrongVersion{bytes};
+        wrongVersion[8] = version;
+        CHECK(!Replay::decode(wrongVersion, decoded));
+    }
+
+    // --- Unplayable setups
+    Replay replay{makeReplay()};
+    replay.tickRate = 0;
+    CHECK(!Replay::decode(replay.encode(), decoded));
+
+    replay                  = makeReplay();
+    replay.match.chaosBalls = UINT32_MAX;
+    CHECK(!Replay::decode(replay.encode(), decoded));
+
+    for (const Rect& field : {Rect{0, 0, 0, 256}, Rect{0, 0, 256, -1},
+                              Rect{0, 0, 100000, 256}}) {
+        replay             = makeReplay();
+        replay.match.field = field;
+        CHECK(!Replay::decode(replay.encode(), decoded));
+    }
+
+    replay = makeReplay();
+    replay.match.obstacles.push_back(Rect{10, 10, 0, 0});
+    CHECK(!Replay::decode(replay.encode(), decoded));
+}
+
+static void checkPlayback() {
+    Match::Config config{
+        .field      = Rect{0, 0, 256, 256},
+        .leftPilot  = {.kind = Pilot::Kind::computer, .accuracy = 0.2f},
+        .rightPilot = {.kind = Pilot::Kind::computer, .accuracy = 0.3f},
+        .chaosBalls = 50,
+        .obstacles  = {Rect{120, 40, 16, 16}},
+        .seed       = 12345,
+    };
+    Replay replay{.tickRate = 60, .match = config};
+
+    // Record the way `Game` plays: reset, serve, step until a point, serve ...
+    InputBus& input{InputBus::get()};
+    Match match{config};
+    match.reset();
+    match.serve();
+    static const uint64_t maxTicks{uint64_t{1} << 22};
+    bool isOver{false};
+    while (!isOver && replay.ticks.size() < maxTicks) {
+        input.setActionState(0);
+        replay.ticks.push_back(0);
+        const Match::Phase phase{match.step(1.0f / replay.tickRate)};
+        isOver = phase == Match::Phase::over;
+        if (phase == Match::Phase::point) {
+            match.serve();
+        }
+    }
+    CHECK(isOver);
+    replay.leftScore  = match.getLeftScore().getValue();
+    replay.rightScore = match.getRightScore().getValue();
+
+    Replay decoded;
+    CHECK(Replay::decode(replay.encode(), decoded));
+    const ReplayPlayer::Outcome outcome{ReplayPlayer::play(decoded)};
+    CHECK(outcome.matches);
+    CHECK(outcome.leftScore == replay.leftScore);
+    CHECK(outcome.rightScore == replay.rightScore);
+    CHECK(outcome.ticks == replay.ticks.size());
+
+    // Another seed is another match.
+    decoded.match.seed = 54321;
+    CHECK(!ReplayPlayer::play(decoded).matches);
+}
+
+int main() {
+    // Rejections are expected; their errors would only be noise.
+    spdlog::set_level(spdlog::level::off);
+
+    checkRoundTrip();
+    checkRejected();
+    checkPlayback();
+
+    return finishTests();
+}
@@ -0,0 +1,79 @@
+#include <cstdlib>
+#include <initializer_list>
+
+#include <SDL_timer.h>
+
+#include "spdlog/common.h"
+#include <spdlog/spdlog.h>
+
+#include "game/match_farm.h"
+
+/**
+ * Headless batch runner.
+ *
+ * Plays computer-vs-computer matches in parallel with no window, renderer,
+ * or frame pacing, then reports throughput.
+ *
+ * Usage:
+ *   pong-headless [matches] [threads] [left accuracy] [right accuracy]
+ *                 [chaos balls] [chaos collisions] [seed]
+ *
+ * A thread count of zero (the default) uses one per hardware thread.
+ * Accuracies must be in [0, 1] (see `Pilot::accuracy`).
+ * Chaos collisions (0 or 1) make chaos balls bounce off each other.
+ * Runs with the same arguments (seed included) report the same totals.
+ */
+int main(int argc, char** argv) {
+
+    spdlog::set_level(spdlog::level::info);
+
+    const uint64_t matches{argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000};
+    const std::size_t threads{argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0};
+    const float accuracy{Pilot{}.accuracy};
+    const float leftAccuracy{argc > 3 ? std::strtof(argv[3], nullptr) : accuracy};
+    const float rightAccuracy{argc > 4 ? std::strtof(argv[4], nullptr) : accuracy};
+    const uint32_t chaosBalls{
+        argc > 5 ? static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10)) : 0};
+    const bool chaosCollisions{argc > 6 && std::strtoul(argv[6], nullptr, 10) != 0};
+    const uint64_t seed{argc > 7 ? std::strtoull(argv[7], nullptr, 10) : 0};
+
+    for (float pilotAccuracy : {leftAccuracy, rightAccuracy}) {
+        // (Also rejects NaN, which compares false both ways.)
+        if (!(pilotAccuracy >= 0 && pilotAccuracy <= 1)) {
+            spdlog::error("Accuracy {} is outside [0, 1]!", pilotAccuracy);
+            return 1;
+        }
+    }
+
+    // Same field and tick rate (60 Hz) as the real game.
+    const float delta{1.0f / 60};
+    const Match::Config match{
+        .field           = Rect{0, 0, 256, 256},
+        .leftPilot       = {.kind = Pilot::Kind::computer, .accuracy = leftAccuracy},
+        .rightPilot      = {.kind = Pilot::Kind::computer, .accuracy = rightAccuracy},
+        .chaosBalls      = chaosBalls,
+        .chaosCollisions = chaosCollisions,
+        .seed            = seed,
+    };
+
+    MatchFarm farm{{.threads = threads}};
+
+    const uint64_t startCounter{SDL_GetPerformanceCounter()};
+    const Match::Statistics stats{farm.play(match, matches, delta)};
+    const double seconds{(SDL_GetPerformanceCounter() - startCounter) /
+                         static_cast<double>(SDL_GetPerformanceFrequency())};
+
+    spdlog::info("{} matches, {} points, {} returns, {} ticks in {:.3f}s on {} threads",
+                 stats.matches, stats.points, stats.returns, stats.ticks, seconds,
+                 farm.getThreadCount());
+    spdlog::info("{:.1f} matches/sec, {:.1f} returns/sec, {:.0f} ticks/sec",
+                 stats.matches / seconds, stats.returns / seconds,
+                 stats.ticks / seconds);
+    if (stats.abandoned) {
+        spdlog::warn("{} matches abandoned: rallies longer than {} ticks "
+                     "(pilots too accurate to miss)",
+                     stats.abandoned, match.maxRallyTicks);
+    }
+
+    return 0;
+}
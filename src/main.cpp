@@ -8,15 +8,34 @@ int main(void) {
     spdlog::set_level(spdlog::level::debug);
 
     Game game{{
-        .headless = false,
-        .display{
-            .windowTitle     = "Pong SDL2 C++",
-            .windowPositionX = 256,
-            .windowPositionY = 256,
-            .windowWidth     = 256,
-            .windowHeight    = 256,
+        .app{
+            .headless = false,
+            // Presses land on the tick they happened in, not the next frame.
+            .queueInput = true,
+            .display{
+                .windowTitle     = "Pong SDL2 C++",
+                .windowPositionX = 256,
+                .windowPositionY = 256,
+                .windowWidth     = 768,
+                .windowHeight    = 768,
+                .resizable       = true,
+            },
+            // Attract and pause screens barely change; redraw only that.
+            .renderer{
+                .partialRedraw = true,
+                .logicalWidth  = 256,
+                .logicalHeight = 256,
+            },
+            .pacer{
+                .mode       = FramePacer::Mode::capped,
+                .targetRate = 60,
+            },
+            // Only written by builds with profiling (see `Profiler`).
+            .traceFile = "pong-trace.json",
         },
-        .renderer{},
+        .leftPilot{.kind = Pilot::Kind::human},
+        .rightPilot{.kind = Pilot::Kind::human},
+        .replayFile = "last-match.pongreplay",
     }};
 
     game.start();
@@ -0,0 +1,61 @@
+#include <cstdlib>
+
+#include <SDL_timer.h>
+
+#include "spdlog/common.h"
+#include <spdlog/spdlog.h>
+
+#include "game/replay.h"
+
+/**
+ * Replay player.
+ *
+ * Plays a recorded match (see `Replay`, `Game::Config::replayFile`) back
+ * with no window, renderer, or frame pacing, and checks that it ends with
+ * the recorded score. Exits non-zero if it doesn't, so replays double as
+ * physics regression tests.
+ *
+ * Usage:
+ *   pong-replay <replay file> [repeat]
+ *
+ * Repeating the playback gives a steadier speed measurement.
+ */
+int main(int argc, char** argv) {
+
+    spdlog::set_level(spdlog::level::info);
+
+    if (argc < 2) {
+        spdlog::error("Usage: pong-replay <replay file> [repeat]");
+        return 2;
+    }
+    const uint64_t repeat{argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1};
+
+    Replay replay;
+    if (!Replay::load(argv[1], replay)) {
+        return 2;
+    }
+
+    ReplayPlayer::Outcome outcome;
+    const uint64_t startCounter{SDL_GetPerformanceCounter()};
+    for (uint64_t idx = 0; idx < repeat; ++idx) {
+        outcome = ReplayPlayer::play(replay);
+    }
+    const double seconds{(SDL_GetPerformanceCounter() - startCounter) /
+                         static_cast<double>(SDL_GetPerformanceFrequency())};
+
+    const double realSeconds{static_cast<double>(outcome.ticks) / replay.tickRate};
+    spdlog::info("{}: {} ticks ({:.1f}s of play), seed {}", argv[1], outcome.ticks,
+                 realSeconds, replay.match.seed);
+    spdlog::info("Played {} times in {:.3f}s, {:.0f}x real time", repeat, seconds,
+                 realSeconds * repeat / seconds);
+
+    if (!outcome.matches) {
+        spdlog::error("Mismatch! Recorded {}-{} in {} ticks, replayed {}-{} in {}",
+                      replay.leftScore, replay.rightScore, replay.ticks.size(),
+                      outcome.leftScore, outcome.rightScore, outcome.ticks);
+        return 1;
+    }
+    spdlog::info("Final score {}-{}, as recorded.", outcome.leftScore,
+                 outcome.rightScore);
+    return 0;
+}